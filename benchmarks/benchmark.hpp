@@ -0,0 +1,80 @@
+// A minimal harness for the runtime benchmarks in this directory.
+//
+// Every benchmark executable times a handful of variants over a few sizes and prints one line of
+// JSON per measurement to stdout, e.g.
+//
+//   {"benchmark": "sum_double", "variant": "fold_tree", "size": 32, "ns_per_call": 4.21}
+//
+// so that the results of several executables can be concatenated and compared by a script.
+
+#ifndef INCLUDE_GUARD_8E2B4D17_C6A3_4F95_B0E1_7A9C3D5F2B64
+#define INCLUDE_GUARD_8E2B4D17_C6A3_4F95_B0E1_7A9C3D5F2B64
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <limits>
+#include <string>
+
+namespace vta_benchmark {
+
+// Forces value to be computed even though it is never used
+template <typename T>
+inline void do_not_optimize(T const& value) {
+#if defined(__GNUC__)
+	asm volatile("" : : "r,m"(value) : "memory");
+#else
+	static volatile char const* sink;
+	sink = reinterpret_cast<volatile char const*>(&value);
+#endif
+}
+
+// Makes the compiler assume that object has been modified, so that anything computed from it
+// cannot be hoisted out of the benchmark loop
+template <typename T>
+inline void clobber(T& object) {
+#if defined(__GNUC__)
+	asm volatile("" : "+m"(object) : : "memory");
+#else
+	static volatile void* sink;
+	sink = &object;
+#endif
+}
+
+// Returns the fastest average time, in nanoseconds, that f took over iterations calls in each of
+// repetitions runs
+template <typename Function>
+double nanoseconds_per_call(Function&& f, std::size_t iterations = 1 << 20, int repetitions = 7) {
+	using clock = std::chrono::steady_clock;
+
+	double best = std::numeric_limits<double>::infinity();
+	for(int r = 0; r < repetitions; ++r) {
+		auto const start = clock::now();
+		for(std::size_t i = 0; i < iterations; ++i) {
+			f();
+		}
+		std::chrono::duration<double, std::nano> const elapsed = clock::now() - start;
+		best = std::min(best, elapsed.count() / static_cast<double>(iterations));
+	}
+	return best;
+}
+
+// Writes a single measurement as a line of JSON
+inline void report(std::string const& benchmark, std::string const& variant, std::size_t size,
+                   double ns_per_call) {
+	std::cout << "{\"benchmark\": \"" << benchmark << "\", \"variant\": \"" << variant
+	          << "\", \"size\": " << size << ", \"ns_per_call\": " << ns_per_call << "}"
+	          << std::endl;
+}
+
+// Writes a single measurement of something other than time, e.g. "bytes_per_record", as a line of JSON
+inline void report(std::string const& benchmark, std::string const& variant, std::size_t size,
+                   std::string const& metric, double value) {
+	std::cout << "{\"benchmark\": \"" << benchmark << "\", \"variant\": \"" << variant
+	          << "\", \"size\": " << size << ", \"" << metric << "\": " << value << "}" << std::endl;
+}
+
+} // namespace vta_benchmark
+
+#endif
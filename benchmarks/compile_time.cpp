@@ -0,0 +1,582 @@
+// Compile-time scaling benchmark for include/vta/algorithms.hpp
+//
+// For every benchmark case and pack size this program generates a translation unit that calls the
+// algorithm with a pack of that many distinct types, compiles it and records the wall time, the
+// peak resident set size of the compiler, the size of the object file and the minimum
+// -ftemplate-depth needed to compile it. The results are written as JSON so that regressions show
+// up as numbers.
+//
+// usage: compile_time_benchmark [--output FILE] [--sizes 1,8,32,128,512] [--cases reverse,swap]
+//                               [--timeout SECONDS] [--max-depth N] [--no-depth]
+//                               [--work-dir DIR] [--flag FLAG]...
+
+#include "compile_time_config.hpp"
+
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+/**************************************************************************************************
+ * Generated code                                                                                 *
+ **************************************************************************************************/
+
+// The pack passed to every algorithm is arg<0>{}, arg<1>{}, ..., arg<N - 1>{}
+std::string type_pack(int n) {
+	std::ostringstream ss;
+	for(int i = 0; i < n; ++i) {
+		ss << (i == 0 ? "" : ", ") << "arg<" << i << ">";
+	}
+	return ss.str();
+}
+
+std::string value_pack(int n) {
+	std::ostringstream ss;
+	for(int i = 0; i < n; ++i) {
+		ss << (i == 0 ? "" : ", ") << "arg<" << i << ">{}";
+	}
+	return ss.str();
+}
+
+std::string int_pack(int n) {
+	std::ostringstream ss;
+	for(int i = 0; i < n; ++i) {
+		ss << (i == 0 ? "" : ", ") << i;
+	}
+	return ss.str();
+}
+
+std::string forward_after(std::string const& transformation, int n) {
+	return "vta::forward_after<" + transformation + ">(sink{})(" + value_pack(n) + ");";
+}
+
+// The types forwarded by a transformation, computed through its transform function
+std::string decltype_types(std::string const& transformation, int n) {
+	std::string declvals;
+	for(int i = 0; i < n; ++i) {
+		declvals += (i == 0 ? "std::declval<arg<" : ", std::declval<arg<") + std::to_string(i) + ">>()";
+	}
+	return "typedef decltype(vta::forward_after<" + transformation + ">(record_types{})(" + declvals
+	       + ")) types; static_cast<void>(types{});";
+}
+
+// The same types computed by the type_list alias template
+std::string type_list_types(std::string const& alias, std::string const& arguments, int n) {
+	return "typedef " + alias + "<vta::type_list<" + type_pack(n) + ">" + arguments
+	       + "> types; static_cast<void>(types{});";
+}
+
+// Returns a comma separated list of unique positions in [0, n) to pass to vta::cycle
+std::string cycle_positions(int n) {
+	std::vector<int> positions{0, n / 2, n - 1};
+	positions.erase(std::unique(positions.begin(), positions.end()), positions.end());
+	std::ostringstream ss;
+	for(std::size_t i = 0; i < positions.size(); ++i) {
+		ss << (i == 0 ? "" : ", ") << positions[i];
+	}
+	return ss.str();
+}
+
+// A chain of positional transformations composed by compose
+std::string compose_chain(std::string const& compose, int n) {
+	return compose + "<vta::reverse, vta::shift<" + std::to_string(n / 2)
+	       + ">, vta::swap<0, -1>, vta::filter<is_even>, vta::reverse, vta::shift_tail<" + std::to_string(n / 4)
+	       + ">>";
+}
+
+struct benchmark_case {
+	char const* name;
+	std::string (*body)(int n);
+};
+
+// Cases prefixed with legacy_ measure the implementations in legacy.hpp that the current ones
+// replaced.
+benchmark_case const cases[] = {
+	{"reverse", [](int n) { return forward_after("vta::reverse", n); }},
+	{"swap", [](int n) { return forward_after("vta::swap<0, -1>", n); }},
+	{"cycle", [](int n) { return forward_after("vta::cycle<" + cycle_positions(n) + ">", n); }},
+	{"shift", [](int n) { return forward_after("vta::shift<" + std::to_string(n / 2) + ">", n); }},
+	{"shift_tail", [](int n) {
+		return forward_after("vta::shift_tail<" + std::to_string(n / 2) + ">", n);
+	}},
+	{"filter", [](int n) { return forward_after("vta::filter<is_even>", n); }},
+	{"compose", [](int n) { return forward_after(compose_chain("vta::compose", n), n); }},
+	{"slice", [](int n) {
+		return forward_after("vta::slice<" + std::to_string(n / 4) + ", "
+		                     + std::to_string(n - 1 - n / 4) + ">", n);
+	}},
+	{"take", [](int n) { return forward_after("vta::take<" + std::to_string(n / 2) + ">", n); }},
+	{"drop", [](int n) { return forward_after("vta::drop<" + std::to_string(n / 2) + ">", n); }},
+	{"at", [](int n) {
+		return "vta::at<" + std::to_string(n / 2) + ">(" + value_pack(n) + ");";
+	}},
+	{"last", [](int n) { return "vta::last(" + value_pack(n) + ");"; }},
+	{"at_t", [](int n) {
+		return "static_assert(std::is_same<vta::at_t<-1>::type<" + type_pack(n) + ">, arg<"
+		       + std::to_string(n - 1) + ">>::value, \"\");";
+	}},
+	// Reverses the pack using negative positions
+	{"permute", [](int n) {
+		std::string positions;
+		for(int i = 0; i < n; ++i) {
+			positions += (i == 0 ? "" : ", ") + std::to_string(-1 - i);
+		}
+		return forward_after("vta::permute<" + positions + ">", n);
+	}},
+	// Computing the types alone with type_list against decltype through forward_after
+	{"reverse_t", [](int n) { return type_list_types("vta::reverse_t", "", n); }},
+	{"decltype_reverse", [](int n) { return decltype_types("vta::reverse", n); }},
+	{"filter_t", [](int n) { return type_list_types("vta::filter_t", ", is_even", n); }},
+	{"decltype_filter", [](int n) { return decltype_types("vta::filter<is_even>", n); }},
+	{"unique_t", [](int n) { return type_list_types("vta::unique_t", "", n); }},
+	{"legacy_reverse", [](int n) { return forward_after("vta_legacy::reverse", n); }},
+	{"legacy_swap", [](int n) { return forward_after("vta_legacy::swap<0, -1>", n); }},
+	{"legacy_cycle", [](int n) {
+		return forward_after("vta_legacy::cycle<" + cycle_positions(n) + ">", n);
+	}},
+	{"legacy_shift", [](int n) {
+		return forward_after("vta_legacy::shift<" + std::to_string(n / 2) + ">", n);
+	}},
+	{"legacy_shift_tail", [](int n) {
+		return forward_after("vta_legacy::shift_tail<" + std::to_string(n / 2) + ">", n);
+	}},
+	{"legacy_slice", [](int n) {
+		return forward_after("vta_legacy::slice<" + std::to_string(n / 4) + ", "
+		                     + std::to_string(n - 1 - n / 4) + ">", n);
+	}},
+	{"legacy_take", [](int n) {
+		return forward_after("vta_legacy::take<" + std::to_string(n / 2) + ">", n);
+	}},
+	{"legacy_drop", [](int n) {
+		return forward_after("vta_legacy::drop<" + std::to_string(n / 2) + ">", n);
+	}},
+	{"legacy_filter", [](int n) { return forward_after("vta_legacy::filter<is_even>", n); }},
+	{"legacy_adjacent_map", [](int n) {
+		return n < 2 ? std::string{"vta::map(sink{})(arg<0>{});"}
+		             : "vta_legacy::adjacent_map<2>(sink{})(" + value_pack(n) + ");";
+	}},
+	{"legacy_adjacent_map_wide", [](int n) {
+		return "vta_legacy::adjacent_map<" + std::to_string(std::max(n / 2, 1)) + ">(sink{})(" + value_pack(n)
+		       + ");";
+	}},
+	{"legacy_compose", [](int n) {
+		return forward_after(compose_chain("vta_legacy::compose", n), n);
+	}},
+	{"legacy_at", [](int n) {
+		return "vta_legacy::at<" + std::to_string(n / 2) + ">(" + value_pack(n) + ");";
+	}},
+	{"legacy_last", [](int n) { return "vta_legacy::last(" + value_pack(n) + ");"; }},
+	{"legacy_at_t", [](int n) {
+		return "static_assert(std::is_same<vta_legacy::at_t<-1>::type<" + type_pack(n) + ">, arg<"
+		       + std::to_string(n - 1) + ">>::value, \"\");";
+	}},
+	{"map", [](int n) { return "vta::map(sink{})(" + value_pack(n) + ");"; }},
+	{"adjacent_map", [](int n) {
+		return n < 2 ? std::string{"vta::map(sink{})(arg<0>{});"}
+		             : "vta::adjacent_map<2>(sink{})(" + value_pack(n) + ");";
+	}},
+	// Windows of half the pack
+	{"adjacent_map_wide", [](int n) {
+		return "vta::adjacent_map<" + std::to_string(std::max(n / 2, 1)) + ">(sink{})(" + value_pack(n)
+		       + ");";
+	}},
+	{"dispatch_bools", [](int n) {
+		// There is a specialization for each of the 2^n combinations, so n is capped at 10 flags
+		std::string flags;
+		for(int i = 0; i < std::min(n, 10); ++i) {
+			flags += ", flag";
+		}
+		return "extern bool flag; vta::dispatch_bools(sink{}" + flags + ");";
+	}},
+	// foldl needs at least two arguments so it is seeded with an initial value
+	{"foldl", [](int n) { return "vta::foldl(first{})(0, " + value_pack(n) + ");"; }},
+	{"foldr", [](int n) { return "vta::foldr(first{})(" + value_pack(n) + ");"; }},
+	{"fold_tree", [](int n) { return "vta::fold_tree(first{})(" + value_pack(n) + ");"; }},
+	{"all_of", [](int n) { return "vta::all_of(always{})(" + value_pack(n) + ");"; }},
+	{"are_same", [](int n) {
+		std::string ints;
+		for(int i = 0; i < n; ++i) {
+			ints += (i == 0 ? "int" : ", int");
+		}
+		return "static_assert(vta::are_same<" + ints + ">::value, \"\");";
+	}},
+	{"are_unique", [](int n) {
+		return "static_assert(vta::are_unique<" + type_pack(n) + ">::value, \"\");";
+	}},
+	{"are_unique_ints", [](int n) {
+		return "static_assert(vta::are_unique_ints<" + int_pack(n) + ">::value, \"\");";
+	}},
+	{"legacy_are_same", [](int n) {
+		std::string ints;
+		for(int i = 0; i < n; ++i) {
+			ints += (i == 0 ? "int" : ", int");
+		}
+		return "static_assert(vta_legacy::are_same<" + ints + ">::value, \"\");";
+	}},
+	{"legacy_are_unique", [](int n) {
+		return "static_assert(vta_legacy::are_unique<" + type_pack(n) + ">::value, \"\");";
+	}},
+	{"legacy_are_unique_ints", [](int n) {
+		return "static_assert(vta_legacy::are_unique_ints<" + int_pack(n) + ">::value, \"\");";
+	}},
+};
+
+std::string translation_unit(benchmark_case const& c, int n) {
+	std::ostringstream ss;
+	ss << "#include \"vta/algorithms.hpp\"\n"
+	   << "#include \"vta/type_list.hpp\"\n"
+	   << "#include \"legacy.hpp\"\n"
+	   << "#include <type_traits>\n"
+	   << "#include <utility>\n"
+	   << "\n"
+	   << "template <int I> struct arg {};\n"
+	   << "\n"
+	   << "template <typename T> struct is_even : std::false_type {};\n"
+	   << "template <int I> struct is_even<arg<I>> : std::integral_constant<bool, I % 2 == 0> {};\n"
+	   << "\n"
+	   << "struct sink {\n"
+	   << "\ttemplate <typename... Args>\n"
+	   << "\tvoid operator()(Args&&...) const {}\n"
+	   << "};\n"
+	   << "\n"
+	   << "struct first {\n"
+	   << "\ttemplate <typename T, typename U>\n"
+	   << "\tT operator()(T t, U) const { return t; }\n"
+	   << "};\n"
+	   << "\n"
+	   << "struct always {\n"
+	   << "\ttemplate <typename T>\n"
+	   << "\tbool operator()(T const&) const { return true; }\n"
+	   << "};\n"
+	   << "\n"
+	   << "struct record_types {\n"
+	   << "\ttemplate <typename... Args>\n"
+	   << "\tvta::type_list<Args...> operator()(Args&&...) const { return {}; }\n"
+	   << "};\n"
+	   << "\n"
+	   << "void run() {\n"
+	   << "\t" << c.body(n) << "\n"
+	   << "}\n";
+	return ss.str();
+}
+
+/**************************************************************************************************
+ * Running the compiler                                                                           *
+ **************************************************************************************************/
+
+struct compile_result {
+	enum status_type { ok, error, timeout };
+
+	status_type status;
+	double wall_seconds;
+	long peak_rss_kb;
+};
+
+char const* to_string(compile_result::status_type status) {
+	switch(status) {
+		case compile_result::ok:      return "ok";
+		case compile_result::error:   return "error";
+		case compile_result::timeout: return "timeout";
+	}
+	return "unknown";
+}
+
+// Runs `command` in its own process group with stdout and stderr redirected to `log`, killing the
+// whole group if it takes longer than `timeout` seconds.
+compile_result run(std::vector<std::string> const& command, std::string const& log, int timeout) {
+	auto const start = std::chrono::steady_clock::now();
+	pid_t const pid = fork();
+	if(pid < 0) {
+		throw std::runtime_error{"fork failed"};
+	}
+
+	if(pid == 0) {
+		setpgid(0, 0);
+		int const fd = open(log.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+		if(fd >= 0) {
+			dup2(fd, STDOUT_FILENO);
+			dup2(fd, STDERR_FILENO);
+			close(fd);
+		}
+
+		std::vector<char*> argv;
+		for(auto const& arg : command) {
+			argv.push_back(const_cast<char*>(arg.c_str()));
+		}
+		argv.push_back(nullptr);
+		execvp(argv[0], argv.data());
+		_exit(127);
+	}
+
+	setpgid(pid, pid);
+	int status = 0;
+	rusage usage{};
+	bool timed_out = false;
+	while(wait4(pid, &status, WNOHANG, &usage) == 0) {
+		if(std::chrono::steady_clock::now() - start > std::chrono::seconds{timeout}) {
+			kill(-pid, SIGKILL);
+			wait4(pid, &status, 0, &usage);
+			timed_out = true;
+			break;
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds{5});
+	}
+
+	std::chrono::duration<double> const elapsed = std::chrono::steady_clock::now() - start;
+
+	// ru_maxrss includes the compiler proper (e.g. cc1plus) as it is a waited-for descendant
+#ifdef __APPLE__
+	long const peak_rss_kb = usage.ru_maxrss / 1024;
+#else
+	long const peak_rss_kb = usage.ru_maxrss;
+#endif
+
+	compile_result result;
+	result.status = timed_out ? compile_result::timeout
+	              : (WIFEXITED(status) && WEXITSTATUS(status) == 0) ? compile_result::ok
+	              : compile_result::error;
+	result.wall_seconds = elapsed.count();
+	result.peak_rss_kb = peak_rss_kb;
+	return result;
+}
+
+struct options {
+	std::string output = "compile_time.json";
+	std::string work_dir = "compile_time_sources";
+	std::vector<int> sizes = {1, 8, 32, 128, 512};
+	std::vector<std::string> cases;
+	std::vector<std::string> flags;
+	int timeout = 300;
+	int max_depth = 2048;
+	bool measure_depth = true;
+};
+
+std::vector<std::string> compile_command(options const& opts,
+                                         std::string const& source,
+                                         std::string const& object,
+                                         int depth,
+                                         bool syntax_only) {
+	std::vector<std::string> command{VTA_BENCHMARK_CXX,
+	                                 VTA_BENCHMARK_STD,
+	                                 "-I" VTA_BENCHMARK_INCLUDE_DIR,
+	                                 "-I" VTA_BENCHMARK_SOURCE_DIR,
+	                                 "-ftemplate-depth=" + std::to_string(depth)};
+	command.insert(command.end(), opts.flags.begin(), opts.flags.end());
+	if(syntax_only) {
+		command.push_back("-fsyntax-only");
+	} else {
+		command.push_back("-c");
+		command.push_back("-o");
+		command.push_back(object);
+	}
+	command.push_back(source);
+	return command;
+}
+
+// Returns the size in bytes of the file at path, or -1 if it cannot be read
+long object_bytes(std::string const& path) {
+	struct stat info;
+	return stat(path.c_str(), &info) == 0 ? static_cast<long>(info.st_size) : -1;
+}
+
+// Finds the smallest -ftemplate-depth that `source` compiles with, given that it compiles with
+// opts.max_depth.
+int instantiation_depth(options const& opts, std::string const& source, std::string const& log) {
+	int lo = 1;
+	int hi = opts.max_depth;
+	while(lo < hi) {
+		int const mid = lo + (hi - lo) / 2;
+		auto const result = run(compile_command(opts, source, "", mid, true), log, opts.timeout);
+		if(result.status == compile_result::ok) {
+			hi = mid;
+		} else {
+			lo = mid + 1;
+		}
+	}
+	return hi;
+}
+
+/**************************************************************************************************
+ * Command line                                                                                   *
+ **************************************************************************************************/
+
+std::vector<std::string> split(std::string const& list) {
+	std::vector<std::string> items;
+	std::istringstream ss{list};
+	std::string item;
+	while(std::getline(ss, item, ',')) {
+		if(!item.empty()) {
+			items.push_back(item);
+		}
+	}
+	return items;
+}
+
+options parse(int argc, char** argv) {
+	options opts;
+	for(int i = 1; i < argc; ++i) {
+		std::string const arg = argv[i];
+		auto const value = [&]() -> std::string {
+			if(i + 1 == argc) {
+				throw std::invalid_argument{"missing value for " + arg};
+			}
+			return argv[++i];
+		};
+
+		if(arg == "--output") {
+			opts.output = value();
+		} else if(arg == "--work-dir") {
+			opts.work_dir = value();
+		} else if(arg == "--sizes") {
+			opts.sizes.clear();
+			for(auto const& size : split(value())) {
+				opts.sizes.push_back(std::stoi(size));
+			}
+		} else if(arg == "--cases") {
+			opts.cases = split(value());
+		} else if(arg == "--flag") {
+			opts.flags.push_back(value());
+		} else if(arg == "--timeout") {
+			opts.timeout = std::stoi(value());
+		} else if(arg == "--max-depth") {
+			opts.max_depth = std::stoi(value());
+		} else if(arg == "--no-depth") {
+			opts.measure_depth = false;
+		} else {
+			throw std::invalid_argument{"unknown argument " + arg};
+		}
+	}
+
+	for(int size : opts.sizes) {
+		if(size < 1) {
+			throw std::invalid_argument{"pack sizes must be at least 1"};
+		}
+	}
+
+	for(auto const& name : opts.cases) {
+		auto const found = std::find_if(std::begin(cases), std::end(cases),
+		                                [&](benchmark_case const& c) { return name == c.name; });
+		if(found == std::end(cases)) {
+			throw std::invalid_argument{"unknown case " + name};
+		}
+	}
+
+	return opts;
+}
+
+bool selected(options const& opts, benchmark_case const& c) {
+	return opts.cases.empty()
+	    || std::find(opts.cases.begin(), opts.cases.end(), c.name) != opts.cases.end();
+}
+
+std::string escape(std::string const& str) {
+	std::string escaped;
+	for(char c : str) {
+		if(c == '"' || c == '\\') {
+			escaped += '\\';
+		}
+		escaped += c;
+	}
+	return escaped;
+}
+
+}
+
+int main(int argc, char** argv) try {
+	options const opts = parse(argc, argv);
+	mkdir(opts.work_dir.c_str(), 0755);
+
+	std::ofstream report{opts.output};
+	if(!report) {
+		throw std::runtime_error{"cannot open " + opts.output};
+	}
+
+	std::string flags = VTA_BENCHMARK_STD;
+	for(auto const& flag : opts.flags) {
+		flags += " " + flag;
+	}
+
+	report << "{\n"
+	       << "  \"compiler\": \"" << escape(VTA_BENCHMARK_CXX) << "\",\n"
+	       << "  \"flags\": \"" << escape(flags) << "\",\n"
+	       << "  \"max_depth\": " << opts.max_depth << ",\n"
+	       << "  \"results\": [";
+
+	bool first = true;
+	bool all_ok = true;
+	for(auto const& c : cases) {
+		if(!selected(opts, c)) {
+			continue;
+		}
+
+		for(int n : opts.sizes) {
+			std::string const stem = opts.work_dir + "/" + c.name + "_" + std::to_string(n);
+			std::string const source = stem + ".cpp";
+			std::string const log = stem + ".log";
+			std::ofstream{source} << translation_unit(c, n);
+
+			std::string const object = stem + ".o";
+			auto const result = run(compile_command(opts, source, object, opts.max_depth, false),
+			                        log,
+			                        opts.timeout);
+			long const bytes = result.status == compile_result::ok ? object_bytes(object) : -1;
+			int const depth = (opts.measure_depth && result.status == compile_result::ok)
+			                ? instantiation_depth(opts, source, log)
+			                : -1;
+			all_ok = all_ok && result.status == compile_result::ok;
+
+			report << (first ? "\n" : ",\n")
+			       << "    {\"case\": \"" << c.name << "\", "
+			       << "\"size\": " << n << ", "
+			       << "\"status\": \"" << to_string(result.status) << "\", "
+			       << "\"wall_seconds\": " << result.wall_seconds << ", "
+			       << "\"peak_rss_kb\": " << result.peak_rss_kb << ", "
+			       << "\"object_bytes\": ";
+			if(bytes < 0) {
+				report << "null, ";
+			} else {
+				report << bytes << ", ";
+			}
+			report << "\"instantiation_depth\": ";
+			if(depth < 0) {
+				report << "null}";
+			} else {
+				report << depth << "}";
+			}
+			report.flush();
+			first = false;
+
+			std::cout << c.name << " " << n << ": " << to_string(result.status) << " "
+			          << result.wall_seconds << "s " << result.peak_rss_kb << "KiB";
+			if(bytes >= 0) {
+				std::cout << " " << bytes << "B";
+			}
+			if(depth >= 0) {
+				std::cout << " depth " << depth;
+			}
+			std::cout << std::endl;
+		}
+	}
+
+	report << "\n  ]\n}\n";
+	return all_ok ? EXIT_SUCCESS : EXIT_FAILURE;
+} catch(std::exception const& e) {
+	std::cerr << "compile_time_benchmark: " << e.what() << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,74 @@
+// Runtime benchmark of vta::dispatch_bools against testing the flags inside the loop
+//
+// Each call runs a loop over a buffer in which each of a number of runtime flags enables one step
+// of the loop body. Testing the flags inside the loop leaves a branch or a select for each step on
+// every iteration, while dispatch_bools makes one indirect call into a copy of the loop that was
+// compiled for exactly that combination of flags. The price is one copy of the loop for every
+// combination, which the dispatch_bools case of compile_time_benchmark measures as object size.
+//
+// usage: dispatch_bools_benchmark
+
+#include "benchmark.hpp"
+
+#include "vta/algorithms.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Sums the values, where step J multiplies the running value by 3 and adds J if the J-th flag is
+// set. Flags may be bools or std::integral_constant<bool, B>.
+template <std::size_t... Js, typename... Flags>
+std::uint32_t transform_sum(std::vector<std::uint32_t> const& values, std::index_sequence<Js...>,
+                            Flags... flags) {
+	std::uint32_t sum = 0;
+	for(std::uint32_t x : values) {
+		int const expand[] = {0, (x = flags ? x * 3 + static_cast<std::uint32_t>(Js) : x, 0)...};
+		static_cast<void>(expand);
+		sum += x;
+	}
+	return sum;
+}
+
+template <std::size_t I>
+using always_bool = bool;
+
+template <std::size_t... Js>
+void compare(std::index_sequence<Js...> steps) {
+	std::size_t const size = sizeof...(Js);
+	std::vector<std::uint32_t> values(256);
+	for(std::size_t i = 0; i < values.size(); ++i) {
+		values[i] = static_cast<std::uint32_t>(i);
+	}
+
+	// Every other flag is set
+	std::vector<bool> const flags{(Js % 2 == 0)...};
+	std::uint32_t sum = 0;
+
+	vta_benchmark::report("transform_sum", "branches", size, vta_benchmark::nanoseconds_per_call([&] {
+		vta_benchmark::clobber(values);
+		sum = transform_sum(values, steps, static_cast<always_bool<Js>>(flags[Js])...);
+		vta_benchmark::do_not_optimize(sum);
+	}, 1 << 14));
+
+	vta_benchmark::report("transform_sum", "dispatch_bools", size, vta_benchmark::nanoseconds_per_call([&] {
+		vta_benchmark::clobber(values);
+		sum = vta::dispatch_bools([&](auto... constant_flags) {
+			return transform_sum(values, steps, constant_flags...);
+		}, static_cast<always_bool<Js>>(flags[Js])...);
+		vta_benchmark::do_not_optimize(sum);
+	}, 1 << 14));
+}
+
+}
+
+int main() {
+	compare(std::make_index_sequence<2>{});
+	compare(std::make_index_sequence<4>{});
+	compare(std::make_index_sequence<6>{});
+	compare(std::make_index_sequence<8>{});
+	compare(std::make_index_sequence<10>{});
+}
@@ -0,0 +1,106 @@
+// Runtime benchmark of vta::fanout and vta::minmax against separate folds with vta::foldl
+//
+// Each call computes the sum, minimum and maximum of a pack of values read from a record, first
+// with one foldl per result, each of which reads every argument again, and then with a single
+// fanout. The minimum and maximum alone are also computed with two foldl calls, a fanout of the
+// two and minmax, which compares the arguments in pairs.
+//
+// usage: fanout_benchmark
+
+#include "benchmark.hpp"
+
+#include "vta/algorithms.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <utility>
+
+namespace {
+
+struct sum {
+	template <typename T>
+	T operator()(T lhs, T rhs) const {
+		return lhs + rhs;
+	}
+};
+
+struct minimum {
+	template <typename T>
+	T operator()(T lhs, T rhs) const {
+		return rhs < lhs ? rhs : lhs;
+	}
+};
+
+struct maximum {
+	template <typename T>
+	T operator()(T lhs, T rhs) const {
+		return lhs < rhs ? rhs : lhs;
+	}
+};
+
+template <typename T, std::size_t... Is>
+void compare(char const* benchmark, std::index_sequence<Is...>) {
+	std::size_t const size = sizeof...(Is);
+	std::array<T, size> values{{static_cast<T>((Is * 7919) % 1000)...}};
+
+	vta_benchmark::report(benchmark, "separate_foldl", size, vta_benchmark::nanoseconds_per_call([&] {
+		vta_benchmark::clobber(values);
+		T const total = vta::foldl(sum{})(values[Is]...);
+		T const low = vta::foldl(minimum{})(values[Is]...);
+		T const high = vta::foldl(maximum{})(values[Is]...);
+		vta_benchmark::do_not_optimize(total);
+		vta_benchmark::do_not_optimize(low);
+		vta_benchmark::do_not_optimize(high);
+	}));
+
+	vta_benchmark::report(benchmark, "fanout", size, vta_benchmark::nanoseconds_per_call([&] {
+		vta_benchmark::clobber(values);
+		auto const results = vta::fanout(sum{}, minimum{}, maximum{})(values[Is]...);
+		vta_benchmark::do_not_optimize(results);
+	}));
+}
+
+template <typename T, std::size_t... Is>
+void compare_minmax(char const* benchmark, std::index_sequence<Is...>) {
+	std::size_t const size = sizeof...(Is);
+	std::array<T, size> values{{static_cast<T>((Is * 7919) % 1000)...}};
+
+	vta_benchmark::report(benchmark, "separate_foldl", size, vta_benchmark::nanoseconds_per_call([&] {
+		vta_benchmark::clobber(values);
+		T const low = vta::foldl(minimum{})(values[Is]...);
+		T const high = vta::foldl(maximum{})(values[Is]...);
+		vta_benchmark::do_not_optimize(low);
+		vta_benchmark::do_not_optimize(high);
+	}));
+
+	vta_benchmark::report(benchmark, "fanout", size, vta_benchmark::nanoseconds_per_call([&] {
+		vta_benchmark::clobber(values);
+		auto const results = vta::fanout(minimum{}, maximum{})(values[Is]...);
+		vta_benchmark::do_not_optimize(results);
+	}));
+
+	vta_benchmark::report(benchmark, "minmax", size, vta_benchmark::nanoseconds_per_call([&] {
+		vta_benchmark::clobber(values);
+		auto const results = vta::minmax(values[Is]...);
+		vta_benchmark::do_not_optimize(results);
+	}));
+}
+
+template <typename T>
+void compare_sizes(char const* benchmark, char const* minmax_benchmark) {
+	compare<T>(benchmark, std::make_index_sequence<8>{});
+	compare<T>(benchmark, std::make_index_sequence<32>{});
+	compare<T>(benchmark, std::make_index_sequence<128>{});
+	compare_minmax<T>(minmax_benchmark, std::make_index_sequence<8>{});
+	compare_minmax<T>(minmax_benchmark, std::make_index_sequence<32>{});
+	compare_minmax<T>(minmax_benchmark, std::make_index_sequence<128>{});
+}
+
+}
+
+int main() {
+	compare_sizes<std::int32_t>("sum_min_max_int32", "min_max_int32");
+	compare_sizes<double>("sum_min_max_double", "min_max_double");
+}
@@ -0,0 +1,62 @@
+// Runtime benchmark of vta::fold_tree against vta::foldl
+//
+// foldl computes f(...f(f(arg1, arg2), arg3)..., argN), where every call depends on the one before
+// it, while fold_tree computes independent halves that the CPU can overlap. The difference shows
+// for operations the compiler may not reassociate by itself, such as floating point addition.
+//
+// usage: fold_tree_benchmark
+
+#include "benchmark.hpp"
+
+#include "vta/algorithms.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace {
+
+struct plus {
+	template <typename T>
+	T operator()(T lhs, T rhs) const {
+		return lhs + rhs;
+	}
+};
+
+struct minimum {
+	template <typename T>
+	T operator()(T lhs, T rhs) const {
+		return rhs < lhs ? rhs : lhs;
+	}
+};
+
+template <typename T, typename Fold, std::size_t... Is>
+double time_fold(Fold fold, std::index_sequence<Is...>) {
+	std::array<T, sizeof...(Is)> values{{static_cast<T>(sizeof...(Is) - Is)...}};
+	return vta_benchmark::nanoseconds_per_call([&] {
+		vta_benchmark::clobber(values);
+		vta_benchmark::do_not_optimize(fold(values[Is]...));
+	});
+}
+
+template <typename T, std::size_t N, typename Function>
+void compare(char const* benchmark, Function f) {
+	vta_benchmark::report(benchmark, "foldl", N, time_fold<T>(vta::foldl(f), std::make_index_sequence<N>{}));
+	vta_benchmark::report(benchmark, "fold_tree", N, time_fold<T>(vta::fold_tree(f), std::make_index_sequence<N>{}));
+}
+
+template <typename T, typename Function>
+void compare_sizes(char const* benchmark, Function f) {
+	compare<T, 8>(benchmark, f);
+	compare<T, 32>(benchmark, f);
+	compare<T, 128>(benchmark, f);
+}
+
+}
+
+int main() {
+	compare_sizes<double>("sum_double", plus{});
+	compare_sizes<double>("min_double", minimum{});
+	compare_sizes<std::uint64_t>("sum_uint64", plus{});
+}
@@ -0,0 +1,151 @@
+// Runtime benchmark of vta::foldl_into against vta::foldl for accumulators that are expensive to
+// create
+//
+// The first case builds a string from a mix of std::strings, string literals and chars as
+// examples/concat.cpp does. foldl with lhs + rhs makes a new string at every step, and foldl with a
+// function that takes the string by value, appends to it and returns it moves it at every step,
+// while foldl_into appends to the same string throughout. The second case counts values into a
+// histogram held in a struct, which foldl copies at every step. Allocations are counted by
+// replacing the global operator new.
+//
+// usage: foldl_into_benchmark
+
+#include "benchmark.hpp"
+
+#include "vta/algorithms.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace {
+
+std::size_t allocations = 0;
+
+}
+
+void* operator new(std::size_t size) {
+	++allocations;
+	if(void* p = std::malloc(size == 0 ? 1 : size)) {
+		return p;
+	}
+	throw std::bad_alloc{};
+}
+
+void operator delete(void* p) noexcept {
+	std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+	std::free(p);
+}
+
+namespace {
+
+// The number of allocations made by a call to f
+template <typename Function>
+double allocations_per_call(Function&& f) {
+	std::size_t const before = allocations;
+	f();
+	return static_cast<double>(allocations - before);
+}
+
+template <typename Function>
+void measure(char const* benchmark, char const* variant, std::size_t size, Function&& f) {
+	vta_benchmark::report(benchmark, variant, size, "allocations_per_call", allocations_per_call(f));
+	vta_benchmark::report(benchmark, variant, size, vta_benchmark::nanoseconds_per_call(f, 1 << 16));
+}
+
+// Alternates between a std::string, a string literal and a char
+template <std::size_t I>
+using piece = std::conditional_t<I % 3 == 0, std::string, std::conditional_t<I % 3 == 1, char const*, char>>;
+
+template <std::size_t I>
+piece<I> make_piece(std::integral_constant<std::size_t, 0>) {
+	return "a field long enough to be allocated";
+}
+
+template <std::size_t I>
+piece<I> make_piece(std::integral_constant<std::size_t, 1>) {
+	return " and a literal";
+}
+
+template <std::size_t I>
+piece<I> make_piece(std::integral_constant<std::size_t, 2>) {
+	return ',';
+}
+
+template <std::size_t... Is>
+void compare_concat(std::index_sequence<Is...>) {
+	std::size_t const size = sizeof...(Is);
+	std::tuple<piece<Is>...> pieces{make_piece<Is>(std::integral_constant<std::size_t, Is % 3>{})...};
+
+	measure("concat", "foldl_plus", size, [&] {
+		vta_benchmark::clobber(pieces);
+		auto const plus = [](std::string const& lhs, auto const& rhs) { return lhs + rhs; };
+		std::string const result = vta::foldl(plus)(std::string(), std::get<Is>(pieces)...);
+		vta_benchmark::do_not_optimize(result);
+	});
+
+	measure("concat", "foldl_append", size, [&] {
+		vta_benchmark::clobber(pieces);
+		auto const append = [](std::string lhs, auto const& rhs) {
+			lhs += rhs;
+			return lhs;
+		};
+		std::string const result = vta::foldl(append)(std::string(), std::get<Is>(pieces)...);
+		vta_benchmark::do_not_optimize(result);
+	});
+
+	measure("concat", "foldl_into", size, [&] {
+		vta_benchmark::clobber(pieces);
+		auto const append = [](std::string& lhs, auto const& rhs) { lhs += rhs; };
+		std::string result;
+		vta::foldl_into(result, append)(std::get<Is>(pieces)...);
+		vta_benchmark::do_not_optimize(result);
+	});
+}
+
+struct histogram {
+	std::array<std::uint32_t, 64> counts;
+};
+
+template <std::size_t... Is>
+void compare_histogram(std::index_sequence<Is...>) {
+	std::size_t const size = sizeof...(Is);
+	std::array<std::uint32_t, size> values{{static_cast<std::uint32_t>((Is * 7919) % 64)...}};
+
+	measure("histogram", "foldl", size, [&] {
+		vta_benchmark::clobber(values);
+		auto const count = [](histogram h, std::uint32_t x) {
+			++h.counts[x % 64];
+			return h;
+		};
+		histogram const result = vta::foldl(count)(histogram{}, values[Is]...);
+		vta_benchmark::do_not_optimize(result);
+	});
+
+	measure("histogram", "foldl_into", size, [&] {
+		vta_benchmark::clobber(values);
+		histogram result{};
+		vta::foldl_into(result, [](histogram& h, std::uint32_t x) { ++h.counts[x % 64]; })(values[Is]...);
+		vta_benchmark::do_not_optimize(result);
+	});
+}
+
+}
+
+int main() {
+	compare_concat(std::make_index_sequence<8>{});
+	compare_concat(std::make_index_sequence<32>{});
+	compare_concat(std::make_index_sequence<128>{});
+	compare_histogram(std::make_index_sequence<8>{});
+	compare_histogram(std::make_index_sequence<32>{});
+	compare_histogram(std::make_index_sequence<128>{});
+}
@@ -0,0 +1,690 @@
+// Previous implementations of algorithms that have since been rewritten in
+// include/vta/algorithms.hpp. They are kept here so that compile_time_benchmark can measure the
+// rewrites against what they replaced.
+
+#ifndef INCLUDE_GUARD_0F4A8C62_73D5_4E21_B6A9_2C5E9D17F384
+#define INCLUDE_GUARD_0F4A8C62_73D5_4E21_B6A9_2C5E9D17F384
+
+#include "vta/algorithms.hpp"
+
+#include <type_traits>
+#include <utility>
+
+namespace vta_legacy {
+
+/**************************************************************************************************
+ * Predicates (recursive, quadratic instantiations for are_unique and are_unique_ints)            *
+ **************************************************************************************************/
+
+template <typename... Args>
+struct are_same;
+
+template <typename First, typename Second, typename... Args>
+struct are_same<First, Second, Args...> {
+	static bool const value = std::is_same<First, Second>::value
+	                       && are_same<Second, Args...>::value;
+};
+
+template <typename Arg>
+struct are_same<Arg> : public std::true_type {};
+
+template <>
+struct are_same<> : public std::true_type {};
+
+template <int... Ns>
+struct are_unique_ints;
+
+template <>
+struct are_unique_ints<> {
+	static bool const value = true;
+};
+
+template <int N>
+struct are_unique_ints<N> {
+	static bool const value = true;
+};
+
+template <int M, int N, int... Ns>
+struct are_unique_ints<M, N, Ns...> {
+	static bool const value = (M != N)
+	                        && are_unique_ints<M, Ns...>::value
+	                        && are_unique_ints<N, Ns...>::value;
+};
+
+template <typename... Args>
+struct are_unique;
+
+template <>
+struct are_unique<> {
+	static bool const value = true;
+};
+
+template <typename Arg>
+struct are_unique<Arg> {
+	static bool const value = true;
+};
+
+template <typename Arg1, typename Arg2, typename... Args>
+struct are_unique<Arg1, Arg2, Args...> {
+	static bool const value = (!std::is_same<Arg1, Arg2>::value)
+	                        && are_unique<Arg1, Args...>::value
+	                        && are_unique<Arg2, Args...>::value;
+};
+
+/**************************************************************************************************
+ * at, last, at_t (recursive, one instantiation per skipped argument)                             *
+ **************************************************************************************************/
+
+template <typename Arg, typename... Args>
+constexpr auto head(Arg&& head, Args&&...) noexcept {
+	return std::forward<Arg>(head);
+}
+
+template <typename Arg>
+constexpr auto last(Arg&& arg) noexcept {
+	return std::forward<Arg>(arg);
+}
+
+template <typename Arg1, typename... Args>
+constexpr auto last(Arg1&&, Args&&... rest) noexcept {
+	return last(std::forward<Args>(rest)...);
+}
+
+namespace detail {
+
+template <unsigned N>
+struct at_helper {
+	template <typename Arg, typename... Args>
+	constexpr static auto get(Arg&&, Args&&... args) noexcept {
+		return at_helper<N - 1>::get(std::forward<Args>(args)...);
+	}
+};
+
+template <>
+struct at_helper<0u> {
+	template <typename... Args>
+	constexpr static auto get(Args&&... args) noexcept {
+		return head(std::forward<Args>(args)...);
+	}
+};
+
+}
+
+template <int N, typename... Args>
+constexpr auto at(Args&&... args) noexcept {
+	constexpr int size = sizeof...(Args);
+	static_assert(-size <= N && N < size, "N is out of bounds");
+	return detail::at_helper<(N + size) % size>::get(std::forward<Args>(args)...);
+}
+
+template <int N>
+struct at_t {
+	template <typename... Args>
+	using type = decltype(at<N>(std::declval<Args>()...));
+};
+
+/**************************************************************************************************
+ * Positional transformations (composed from recursive shifts and drops)                          *
+ **************************************************************************************************/
+
+namespace detail {
+
+template <typename Function, typename... Transforms>
+class compose_helper_f;
+
+template <typename Function, typename FirstTransform, typename... Transforms>
+class compose_helper_f<Function, FirstTransform, Transforms...> {
+	Function mF;
+
+public:
+	constexpr compose_helper_f(Function f)
+	: mF(std::move(f)) {
+	}
+
+	template <typename... Args>
+	constexpr auto operator()(Args&&... args) const {
+		return FirstTransform::transform(compose_helper_f<Function, Transforms...>{mF},
+		                                 std::forward<Args>(args)...);
+	}
+
+	template <typename... Args>
+	auto operator()(Args&&... args) {
+		return FirstTransform::transform(compose_helper_f<Function, Transforms...>{mF},
+		                                 std::forward<Args>(args)...);
+	}
+};
+
+template <typename Function>
+class compose_helper_f<Function> {
+	Function mF;
+
+public:
+	compose_helper_f(Function f)
+	: mF(std::move(f)) {
+	}
+
+	template <typename... Args>
+	constexpr auto operator()(Args&&... args) const {
+		return mF(std::forward<Args>(args)...);
+	}
+
+	template <typename... Args>
+	auto operator()(Args&&... args) {
+		return mF(std::forward<Args>(args)...);
+	}
+};
+
+}
+
+/** Composes a sequence of transformations. */
+template <typename... Transforms>
+struct compose {
+	template <typename Function, typename... Args>
+	constexpr static auto transform(Function&& f, Args&&... args) {
+		typedef detail::compose_helper_f<typename std::remove_reference<Function>::type, Transforms...> Helper;
+		return Helper{f}(std::forward<Args>(args)...);
+	}
+};
+
+/** Forwards the arguments to f without change. */
+struct id {
+	template <typename Function, typename... Args>
+	constexpr static auto transform(Function&& f, Args&&... args) {
+		return std::forward<Function>(f)(std::forward<Args>(args)...);
+	}
+};
+
+/** Calls the function with the given arguments if Condition is true. */
+template <bool Condition>
+struct call_if;
+
+template <>
+struct call_if<true> {
+	template <typename Function, typename... Args>
+	constexpr static auto transform(Function&& f, Args&&... args) {
+		return id::transform(std::forward<Function>(f), std::forward<Args>(args)...);
+	}
+};
+
+template <>
+struct call_if<false> {
+	template <typename Function, typename... Args>
+	constexpr static void transform(Function&&, Args&&...) noexcept {
+	}
+};
+
+/** Flips the first two variables. */
+struct flip {
+	template <typename Function, typename First, typename Second, typename... Args>
+	constexpr static auto transform(Function&& f, First&& first, Second&& second, Args&&... rest) {
+		return std::forward<Function>(f)(std::forward<Second>(second),
+		                                 std::forward<First>(first),
+		                                 std::forward<Args>(rest)...);
+	}
+};
+
+/** Left cyclic shifts the parameters \a n places. */
+template <unsigned N>
+struct left_shift {
+	template <typename Function, typename First, typename... Args>
+	constexpr static auto transform(Function&& f, First&& first, Args&&... rest) {
+		static_assert(N < 1 + sizeof...(rest),
+		  "Cannot left shift more than the size of the parameter pack");
+		return left_shift<N - 1>::transform(std::forward<Function>(f),
+		                                    std::forward<Args>(rest)...,
+		                                    std::forward<First>(first));
+	}
+};
+
+template <>
+struct left_shift<0u> {
+	template <typename Function, typename... Args>
+	constexpr static auto transform(Function&& f, Args&&... rest) {
+		return id::transform(std::forward<Function>(f), std::forward<Args>(rest)...);
+	}
+};
+
+/** Right cyclic shifts the parameters \a n places. */
+template <unsigned N>
+struct right_shift {
+	template <typename Function, typename... Args>
+	constexpr static auto transform(Function&& f, Args&&... args) {
+		static_assert(N < sizeof...(args),
+		  "Cannot right shift more than the size of the parameter pack");
+		return left_shift<sizeof...(Args) - N>::transform(std::forward<Function>(f),
+		                                                  std::forward<Args>(args)...);
+	}
+};
+
+template <>
+struct right_shift<0u> {
+	template <typename Function, typename... Args>
+	constexpr static auto transform(Function&& f, Args&&... rest) {
+		return id::transform(std::forward<Function>(f), std::forward<Args>(rest)...);
+	}
+};
+
+template <int N, bool NotNegative = (N >= 0)>
+struct shift;
+
+template <int N>
+struct shift<N, true> {
+	template <typename Function, typename... Args>
+	constexpr static auto transform(Function&& f, Args&&... args) {
+		return left_shift<N>::transform(std::forward<Function>(f),
+		                                std::forward<Args>(args)...);
+	}
+};
+
+template <int N>
+struct shift<N, false> {
+	template <typename Function, typename... Args>
+	constexpr static auto transform(Function&& f, Args&&... args) {
+		return right_shift<-N>::transform(std::forward<Function>(f),
+		                                  std::forward<Args>(args)...);
+	}
+};
+
+/** Left cyclic shifts the tail of the parameters \a n places. */
+template <unsigned N>
+struct left_shift_tail {
+	template <typename Function, typename Fixed, typename First, typename... Args>
+	constexpr static auto transform(Function&& f, Fixed&& fixed, First&& first, Args&&... rest) {
+		static_assert(N < 1 + sizeof...(rest),
+		  "Cannot left shift more than the size of the tail of the parameter pack");
+		return left_shift_tail<N - 1>::transform(std::forward<Function>(f),
+		                                         std::forward<Fixed>(fixed),
+		                                         std::forward<Args>(rest)...,
+		                                         std::forward<First>(first));
+	}
+};
+
+template <>
+struct left_shift_tail<0u> {
+	template <typename Function, typename... Args>
+	constexpr static auto transform(Function&& f, Args&&... rest) {
+		return id::transform(std::forward<Function>(f), std::forward<Args>(rest)...);
+	}
+};
+
+/** Right cyclic shifts the tail of the parameters \a n places. */
+template <unsigned N>
+struct right_shift_tail {
+	template <typename Function, typename... Args>
+	constexpr static auto transform(Function&& f, Args&&... args) {
+		static_assert(N < sizeof...(args) - 1,
+		  "Cannot right shift more than the size of the tail of the parameter pack");
+		return left_shift_tail<sizeof...(Args) - N - 1>::transform(std::forward<Function>(f),
+		                                                           std::forward<Args>(args)...);
+	}
+};
+
+template <>
+struct right_shift_tail<0u> {
+	template <typename Function, typename... Args>
+	constexpr static auto transform(Function&& f, Args&&... rest) {
+		return id::transform(std::forward<Function>(f), std::forward<Args>(rest)...);
+	}
+};
+
+template <int N, bool NotNegative = (N >= 0)>
+struct shift_tail;
+
+template <int N>
+struct shift_tail<N, true> {
+	template <typename Function, typename... Args>
+	constexpr static auto transform(Function&& f, Args&&... args) {
+		return left_shift_tail<N>::transform(std::forward<Function>(f),
+		                                     std::forward<Args>(args)...);
+	}
+};
+
+template <int N>
+struct shift_tail<N, false> {
+	template <typename Function, typename... Args>
+	constexpr static auto transform(Function&& f, Args&&... args) {
+		return right_shift_tail<-N>::transform(std::forward<Function>(f),
+		                                       std::forward<Args>(args)...);
+	}
+};
+
+namespace detail {
+
+template <unsigned N>
+struct drop_helper {
+	template <typename Function, typename First, typename... Args>
+	constexpr static auto transform(Function&& f, First&&, Args&&... args) {
+		return drop_helper<N - 1>::transform(std::forward<Function>(f), std::forward<Args>(args)...);
+	}
+};
+
+template <>
+struct drop_helper<0u> {
+	template <typename Function, typename... Args>
+	constexpr static auto transform(Function&& f, Args&&... args) {
+		return id::transform(std::forward<Function>(f), std::forward<Args>(args)...);
+	}
+};
+
+}
+
+/** Drops the first N arguments. */
+template <int N>
+struct drop {
+	template <typename Function, typename... Args>
+	constexpr static auto transform(Function&& f, Args&&... args) {
+		constexpr int size = sizeof...(Args);
+		static_assert(-size <= N && N <= size,
+		  "Cannot drop more variables than are passed");
+		return detail::drop_helper<N < 0 ? N + size : N>::transform(std::forward<Function>(f), std::forward<Args>(args)...);
+	}
+};
+
+namespace detail {
+
+template <unsigned N, bool ForwardAll>
+struct take_helper;
+
+template <unsigned N>
+struct take_helper<N, true> {
+	template <typename Function, typename... Args>
+	constexpr static auto transform(Function&& f, Args&&... args) {
+		return id::transform(std::forward<Function>(f), std::forward<Args>(args)...);
+	}
+};
+
+template <unsigned N>
+struct take_helper<N, false> {
+	template <typename Function, typename... Args>
+	constexpr static auto transform(Function&& f, Args&&... args) {
+		return compose<left_shift<N>,
+		               drop<sizeof...(args) - N>
+		              >::transform(std::forward<Function>(f), std::forward<Args>(args)...);
+	}
+};
+
+}
+
+/** Passes only the first N arguments. */
+template <int N>
+struct take {
+	template <typename Function, typename... Args>
+	constexpr static auto transform(Function&& f, Args&&... args) {
+		constexpr int size = sizeof...(Args);
+		static_assert(-size <= N && N <= size, "Cannot take more parameters that are available");
+		return detail::take_helper<N < 0 ? N + size : N,
+		                           N == sizeof...(args)>::transform(std::forward<Function>(f),
+		                                                            std::forward<Args>(args)...);
+	}
+};
+
+template <>
+struct take<0u> {
+	template <typename Function, typename... Args>
+	constexpr static auto transform(Function&& f, Args&&...) {
+		return std::forward<Function>(f)();
+	}
+};
+
+/** Take only the arguments at positions N, N + 1, ..., M - 1, M */
+template <int N, int M>
+struct slice {
+	template <typename Function, typename... Args>
+	constexpr static auto transform(Function&& f, Args&&... args) {
+		constexpr int size = sizeof...(Args);
+		static_assert(-size <= N && N < size,
+		  "N is out of bounds");
+		static_assert(-size <= M && M < size,
+		  "M is out of bounds");
+		constexpr int A = (N + size) % size;
+		constexpr int B = (M + size) % size;
+		static_assert(A <= B, "N must be <= M");
+		static_assert(B <= size, "M is out of bounds");
+		return m_slice<A, B>::transform(std::forward<Function>(f), std::forward<Args>(args)...);
+	}
+
+private:
+	template <unsigned A, unsigned B>
+	struct m_slice {
+		template <typename Function, typename... Args>
+		constexpr static auto transform(Function&& f, Args&&... args) {
+			return compose<left_shift<A>,
+			               drop<sizeof...(args) - (B - A)>
+			              >::transform(std::forward<Function>(f), std::forward<Args>(args)...);
+		}
+	};
+};
+
+/** Swap the parameters in the positions \a n and \a m. If a number is negative, it is counted from
+    the end of the parameter pack. e.g. -1 would be the last parameter. */
+template <int N, int M>
+struct swap {
+	template <typename Function, typename... Args>
+	constexpr static auto transform(Function&& f, Args&&... args) {
+		constexpr int size = sizeof...(Args);
+		static_assert(-size <= N && N < size,
+		  "N is out of bounds");
+		static_assert(-size <= M && M < size,
+		  "M is out of bounds");
+		constexpr int A = (N + size) % size;
+		constexpr int B = (M + size) % size;
+		constexpr int min = A < B ? A : B;
+		constexpr int max = A < B ? B : A;
+		return swap_helper<min, max>::transform(std::forward<Function>(f), std::forward<Args>(args)...);
+	}
+
+private:
+	template <int Min, int Max>
+	struct swap_helper {
+		template <typename Function, typename... Args>
+		constexpr static auto transform(Function&& f, Args&&... args) {
+			return compose<shift<Min>,
+			               shift_tail<Max - Min - 1>,
+			               flip,
+			               shift_tail<-(Max - Min - 1)>,
+			               shift<-Min>
+			              >::transform(std::forward<Function>(f), std::forward<Args>(args)...);
+		}
+	};
+
+	template <int MinMax>
+	struct swap_helper<MinMax, MinMax> {
+		template <typename Function, typename... Args>
+		constexpr static auto transform(Function&& f, Args&&... args) {
+			return id::transform(std::forward<Function>(f), std::forward<Args>(args)...);
+		}
+	};
+};
+
+namespace detail {
+
+template <int N, int Modulus>
+struct modulus {
+	static int const value = (N + Modulus) % Modulus;
+};
+
+}
+
+template <int... Positions>
+struct cycle;
+
+template <>
+struct cycle<> {
+	template <typename Function, typename... Args>
+	constexpr static auto transform(Function&& f, Args&&... args) {
+		return id::transform(std::forward<Function>(f), std::forward<Args>(args)...);
+	}
+};
+
+template <int First>
+struct cycle<First> {
+	template <typename Function, typename... Args>
+	constexpr static auto transform(Function&& f, Args&&... args) {
+		return id::transform(std::forward<Function>(f), std::forward<Args>(args)...);
+	}
+};
+
+template <int First, int Second, int... Rest>
+struct cycle<First, Second, Rest...> {
+	template <typename Function, typename... Args>
+	constexpr static auto transform(Function&& f, Args&&... args) {
+		constexpr int size = sizeof...(Args);
+		static_assert(are_unique_ints<detail::modulus<First, size>::value,
+		                              detail::modulus<Second, size>::value,
+		                              detail::modulus<Rest, size>::value...>::value,
+		  "The positions to permute must be unique");
+		return compose<swap<First, Second>, cycle<First, Rest...>>::transform(std::forward<Function>(f), std::forward<Args>(args)...);
+	}
+};
+
+namespace detail {
+
+template <unsigned N>
+struct reverse_helper {
+	template <typename Function>
+	constexpr static auto transform(Function&&) {
+	}
+
+	template <typename Function, typename Arg>
+	constexpr static auto transform(Function&& f, Arg&& arg) {
+		return id::transform(std::forward<Function>(f), std::forward<Arg>(arg));
+	}
+
+	template <typename Function, typename First, typename... Args>
+	constexpr static auto transform(Function&& f, First&& first, Args&&... args) {
+		return compose<swap<N - 1, -N>,
+		               reverse_helper<N - 1>
+		              >::transform(std::forward<Function>(f),
+		                           std::forward<First>(first),
+		                           std::forward<Args>(args)...);
+	}
+};
+
+template <>
+struct reverse_helper<0u> {
+	template <typename Function, typename... Args>
+	constexpr static auto transform(Function&& f, Args&&... args) {
+		return id::transform(std::forward<Function>(f), std::forward<Args>(args)...);
+	}
+};
+
+}
+
+/** Reverse the order of arguments */
+struct reverse {
+template <typename Function, typename... Args>
+	constexpr static auto transform(Function&& f, Args&&... args) {
+		return detail::reverse_helper<sizeof...(args) / 2>::transform(std::forward<Function>(f),
+		                                                              std::forward<Args>(args)...);
+	}
+};
+
+/**************************************************************************************************
+ * Filter (re-forwards the arguments that passed at every step)                                   *
+ **************************************************************************************************/
+
+namespace detail {
+
+template <template <class> class Predicate, typename... Passed>
+struct filter_helper;
+
+template <template <class> class Predicate, bool BPassed, typename... Passed>
+struct next_has_passed;
+
+template <template <class> class Predicate, typename... Passed>
+struct next_has_passed<Predicate, true, Passed...> {
+	template <typename Function, typename Next, typename... ToBeEvaluated>
+	constexpr static decltype(auto) transform(Function&& f, Passed&&... passed, Next&& next, ToBeEvaluated&&... rest) {
+		return filter_helper<Predicate, Passed..., Next>::transform(std::forward<Function>(f),
+		                                                            std::forward<Passed>(passed)...,
+		                                                            std::forward<Next>(next),
+		                                                            std::forward<ToBeEvaluated>(rest)...);
+	}
+
+	template <typename Function>
+	constexpr static decltype(auto) transform(Function&& f, Passed&&... passed) {
+		return std::forward<Function>(f)(std::forward<Passed>(passed)...);
+	}
+};
+
+template <template <class> class Predicate, typename... Passed>
+struct next_has_passed<Predicate, false, Passed...> {
+	template <typename Function, typename Next, typename... ToBeEvaluated>
+	constexpr static decltype(auto) transform(Function&& f, Passed&&... passed, Next&&, ToBeEvaluated&&... rest) {
+		return filter_helper<Predicate, Passed...>::transform(std::forward<Function>(f),
+		                                                      std::forward<Passed>(passed)...,
+		                                                      std::forward<ToBeEvaluated>(rest)...);
+	}
+
+	template <typename Function>
+	constexpr static decltype(auto) transform(Function&& f, Passed&&... passed) {
+		return std::forward<Function>(f)(std::forward<Passed>(passed)...);
+	}
+};
+
+template <template <class> class Predicate, typename... Passed>
+struct filter_helper {
+	template <typename Function, typename Next, typename... ToBeEvaluated>
+	constexpr static decltype(auto) transform(Function&& f, Passed&&... passed, Next&& next, ToBeEvaluated&&... rest) {
+		typedef next_has_passed<Predicate,
+		                        Predicate<Next>::value,
+		                        Passed...> NextTransform;
+		return NextTransform::transform(std::forward<Function>(f),
+		                                std::forward<Passed>(passed)...,
+		                                std::forward<Next>(next),
+		                                std::forward<ToBeEvaluated>(rest)...);
+	}
+
+	template <typename Function, typename... ToBeEvaluated>
+	constexpr static decltype(auto) transform(Function&& f, Passed&&... passed) {
+		return std::forward<Function>(f)(std::forward<Passed>(passed)...);
+	}
+};
+
+}
+
+/** Filter in parameters only if Predicate<Arg>::value is true for each argument type. */
+template <template <class> class Predicate>
+struct filter {
+	template <typename Function, typename... Args>
+	constexpr static decltype(auto) transform(Function&& f, Args&&... args) {
+		typedef detail::filter_helper<Predicate> Next;
+		return Next::transform(std::forward<Function>(f),
+		                       std::forward<Args>(args)...);
+	}
+};
+
+/**************************************************************************************************
+ * adjacent_map (one take and one recursive call per window)                                      *
+ **************************************************************************************************/
+
+template <unsigned N, typename Function>
+class adjacent_map_f {
+	Function mF;
+
+public:
+	constexpr adjacent_map_f(Function f)
+	: mF(std::move(f)) {
+	}
+
+	template <typename First, typename... Args>
+	void operator()(First&& first, Args&&... args) const {
+		vta::take<N>::transform(mF, std::forward<First>(first), args...);
+		vta::call_if<(sizeof...(args) >= N)>::transform(*this, std::forward<Args>(args)...);
+	}
+
+	template <typename First, typename... Args>
+	void operator()(First&& first, Args&&... args) {
+		vta::take<N>::transform(mF, std::forward<First>(first), args...);
+		vta::call_if<(sizeof...(args) >= N)>::transform(*this, std::forward<Args>(args)...);
+	}
+};
+
+template <unsigned N, typename Function>
+constexpr adjacent_map_f<N, typename std::remove_reference<Function>::type> adjacent_map(Function&& f) {
+	return {std::forward<Function>(f)};
+}
+
+}
+
+#endif
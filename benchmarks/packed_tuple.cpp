@@ -0,0 +1,87 @@
+// Memory footprint and scan benchmark of vta::packed_tuple against std::tuple
+//
+// Each record type mixes small and large fields in the order that they would naturally be declared,
+// which leaves padding between them in a std::tuple. packed_tuple lays the same fields out from the
+// most strictly aligned to the least. Both the bytes per record and the time to sum one field over a
+// vector of a million records are reported, where the scan is limited by memory bandwidth and so
+// follows the size of the records.
+//
+// usage: packed_tuple_benchmark
+
+#include "benchmark.hpp"
+
+#include "vta/packed_tuple.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace {
+
+std::size_t const records = 1 << 20;
+
+template <template <class...> class Tuple>
+struct order {
+	// is_buy, price, quantity, side, id, venue
+	typedef Tuple<bool, double, std::int32_t, char, std::int64_t, std::int16_t> type;
+};
+
+template <template <class...> class Tuple>
+struct sensor_reading {
+	// sensor, value, flags, timestamp, status
+	typedef Tuple<std::uint8_t, float, std::uint16_t, double, std::uint8_t> type;
+};
+
+template <template <class...> class Tuple>
+struct trade {
+	// venue, id, is_buy, price, is_cancelled, quantity, is_hidden, timestamp
+	typedef Tuple<char, std::int64_t, bool, double, bool, std::int32_t, bool, std::int64_t> type;
+};
+
+using std::get;
+using vta::get;
+
+// Sums field I of every record
+template <std::size_t I, typename Record>
+double scan(std::vector<Record> const& values) {
+	double sum = 0;
+	for(Record const& r : values) {
+		sum += static_cast<double>(get<I>(r));
+	}
+	return sum;
+}
+
+template <std::size_t I, typename Record>
+void measure(char const* benchmark, char const* variant) {
+	std::size_t const size = std::tuple_size<Record>::value;
+	std::vector<Record> values(records);
+	for(std::size_t i = 0; i < values.size(); ++i) {
+		get<I>(values[i]) = static_cast<std::remove_reference_t<decltype(get<I>(values[i]))>>(i % 1000);
+	}
+
+	vta_benchmark::report(benchmark, variant, size, "bytes_per_record", static_cast<double>(sizeof(Record)));
+	double sum = 0;
+	vta_benchmark::report(benchmark, variant, size, "ns_per_record", vta_benchmark::nanoseconds_per_call([&] {
+		vta_benchmark::clobber(values);
+		sum = scan<I>(values);
+		vta_benchmark::do_not_optimize(sum);
+	}, 16) / static_cast<double>(records));
+}
+
+// Compares the layouts of Record, scanning its field at position I
+template <template <template <class...> class> class Record, std::size_t I>
+void compare(char const* benchmark) {
+	measure<I, typename Record<std::tuple>::type>(benchmark, "std_tuple");
+	measure<I, typename Record<vta::packed_tuple>::type>(benchmark, "packed_tuple");
+}
+
+}
+
+int main() {
+	compare<order, 1>("order_price");
+	compare<sensor_reading, 1>("sensor_reading_value");
+	compare<trade, 3>("trade_price");
+}
@@ -0,0 +1,90 @@
+// Runtime benchmark of vta::par_map against vta::map
+//
+// Each call hashes eight buffers of different element types, standing in for serializing and
+// compressing heterogeneous data. map hashes them one after another, par_map spreads them over a
+// thread_pool. The size reported for par_map is the number of threads in the pool.
+//
+// usage: par_map_benchmark
+
+#include "benchmark.hpp"
+
+#include "vta/parallel.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+template <typename T>
+struct job {
+	explicit job(std::size_t bytes)
+	: data(bytes / sizeof(T))
+	, digest{0} {
+		for(std::size_t i = 0; i < data.size(); ++i) {
+			data[i] = static_cast<T>(i * 7 + 3);
+		}
+	}
+
+	std::vector<T> data;
+	std::uint64_t digest;
+};
+
+// A few rounds of FNV-1a over the bytes of the buffer
+struct hash_job {
+	template <typename T>
+	void operator()(job<T>& j) const {
+		unsigned char const* bytes = reinterpret_cast<unsigned char const*>(j.data.data());
+		std::size_t const size = j.data.size() * sizeof(T);
+
+		std::uint64_t h = 14695981039346656037ull;
+		for(int round = 0; round < 4; ++round) {
+			for(std::size_t i = 0; i < size; ++i) {
+				h = (h ^ bytes[i]) * 1099511628211ull;
+			}
+		}
+		j.digest = h;
+	}
+};
+
+}
+
+int main() {
+	std::size_t const bytes = 256 * 1024;
+	job<char> a{bytes};
+	job<short> b{bytes};
+	job<int> c{bytes};
+	job<long long> d{bytes};
+	job<float> e{bytes};
+	job<double> f{bytes};
+	job<unsigned char> g{bytes};
+	job<unsigned> h{bytes};
+
+	std::size_t const iterations = 10;
+	int const repetitions = 3;
+
+	double const sequential = vta_benchmark::nanoseconds_per_call([&] {
+		vta::map(hash_job{})(a, b, c, d, e, f, g, h);
+		vta_benchmark::do_not_optimize(a.digest ^ h.digest);
+	}, iterations, repetitions);
+	vta_benchmark::report("hash_8_buffers", "map", 1, sequential);
+
+	std::vector<std::size_t> threads{1, 2, 4, 8};
+	std::size_t const hardware = std::thread::hardware_concurrency();
+	if(hardware != 0 && std::find(threads.begin(), threads.end(), hardware) == threads.end()) {
+		threads.push_back(hardware);
+	}
+
+	for(std::size_t n : threads) {
+		vta::thread_pool pool{n};
+		double const parallel = vta_benchmark::nanoseconds_per_call([&] {
+			vta::par_map(hash_job{}, pool)(a, b, c, d, e, f, g, h);
+			vta_benchmark::do_not_optimize(a.digest ^ h.digest);
+		}, iterations, repetitions);
+		vta_benchmark::report("hash_8_buffers", "par_map", n, parallel);
+	}
+}
@@ -0,0 +1,54 @@
+// Runtime benchmark of vta::reduce against vta::foldl and vta::fold_tree
+//
+// When every argument has the same arithmetic type and the operation is one that reduce knows,
+// the arguments are loaded straight into SSE2 or AVX2 vectors and reduced as a balanced tree. foldl
+// is a chain of scalar operations that each depend on the last.
+//
+// usage: reduce_benchmark
+
+#include "benchmark.hpp"
+
+#include "vta/reduce.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+
+namespace {
+
+template <typename T, typename Fold, std::size_t... Is>
+double time_fold(Fold fold, std::index_sequence<Is...>) {
+	std::array<T, sizeof...(Is)> values{{static_cast<T>((Is * 37 + 11) % 101)...}};
+	return vta_benchmark::nanoseconds_per_call([&] {
+		vta_benchmark::clobber(values);
+		vta_benchmark::do_not_optimize(fold(values[Is]...));
+	});
+}
+
+template <typename T, std::size_t N, typename Function>
+void compare(char const* benchmark, Function f) {
+	vta_benchmark::report(benchmark, "foldl", N, time_fold<T>(vta::foldl(f), std::make_index_sequence<N>{}));
+	vta_benchmark::report(benchmark, "fold_tree", N, time_fold<T>(vta::fold_tree(f), std::make_index_sequence<N>{}));
+	vta_benchmark::report(benchmark, "reduce", N, time_fold<T>(vta::reduce(f), std::make_index_sequence<N>{}));
+}
+
+template <typename T, typename Function>
+void compare_sizes(char const* benchmark, Function f) {
+	compare<T, 8>(benchmark, f);
+	compare<T, 16>(benchmark, f);
+	compare<T, 32>(benchmark, f);
+	compare<T, 64>(benchmark, f);
+	compare<T, 128>(benchmark, f);
+}
+
+}
+
+int main() {
+	compare_sizes<float>("sum_float", std::plus<>{});
+	compare_sizes<double>("sum_double", std::plus<>{});
+	compare_sizes<double>("max_double", vta::maximum{});
+	compare_sizes<std::int32_t>("min_int32", vta::minimum{});
+	compare_sizes<std::uint64_t>("xor_uint64", std::bit_xor<>{});
+}
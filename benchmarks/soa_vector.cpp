@@ -0,0 +1,119 @@
+// Runtime benchmark of scanning columns of vta::soa_vector against std::vector<std::tuple<Ts...>>
+//
+// Each call sums one or two fields of every record. With a vector of tuples every cache line that is
+// read also holds the fields that are not needed, whereas each column of a soa_vector is contiguous,
+// so only the memory of the fields that are summed is read.
+// The records are an order with six fields and a wide market data row with twelve.
+//
+// usage: soa_vector_benchmark
+
+#include "benchmark.hpp"
+
+#include "vta/soa_vector.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace {
+
+std::size_t const records = 1 << 20;
+
+// is_buy, price, quantity, side, id, venue
+template <template <class...> class Container>
+using orders = Container<bool, double, std::int32_t, char, std::int64_t, std::int16_t>;
+
+// id, bid, ask, bid_size, ask_size, last, volume, open, high, low, close, timestamp
+template <template <class...> class Container>
+using quotes = Container<std::int64_t, double, double, std::int32_t, std::int32_t, double, std::int64_t,
+                         double, double, double, double, std::int64_t>;
+
+template <typename... Ts>
+using tuple_vector = std::vector<std::tuple<Ts...>>;
+
+template <std::size_t I, typename... Ts>
+double sum_column(tuple_vector<Ts...> const& values) {
+	double sum = 0;
+	for(auto const& t : values) {
+		sum += static_cast<double>(std::get<I>(t));
+	}
+	return sum;
+}
+
+template <std::size_t I, typename... Ts>
+double sum_column(vta::soa_vector<Ts...> const& values) {
+	double sum = 0;
+	for(auto const x : values.template column<I>()) {
+		sum += static_cast<double>(x);
+	}
+	return sum;
+}
+
+template <std::size_t I, std::size_t J, typename... Ts>
+double sum_product(tuple_vector<Ts...> const& values) {
+	double sum = 0;
+	for(auto const& t : values) {
+		sum += static_cast<double>(std::get<I>(t)) * static_cast<double>(std::get<J>(t));
+	}
+	return sum;
+}
+
+template <std::size_t I, std::size_t J, typename... Ts>
+double sum_product(vta::soa_vector<Ts...> const& values) {
+	auto const first = values.template column<I>();
+	auto const second = values.template column<J>();
+	double sum = 0;
+	for(std::size_t i = 0; i < first.size(); ++i) {
+		sum += static_cast<double>(first[i]) * static_cast<double>(second[i]);
+	}
+	return sum;
+}
+
+template <typename... Ts>
+void fill(tuple_vector<Ts...>& values) {
+	values.reserve(records);
+	for(std::size_t i = 0; i < records; ++i) {
+		values.emplace_back(static_cast<Ts>(i % 100)...);
+	}
+}
+
+template <typename... Ts>
+void fill(vta::soa_vector<Ts...>& values) {
+	values.reserve(records);
+	for(std::size_t i = 0; i < records; ++i) {
+		values.emplace_back(static_cast<Ts>(i % 100)...);
+	}
+}
+
+// Sums column I, and the product of columns I and J, of each layout of Records
+template <template <template <class...> class> class Records, std::size_t I, std::size_t J>
+void compare(char const* column_benchmark, char const* product_benchmark) {
+	Records<tuple_vector> tuples;
+	fill(tuples);
+	Records<vta::soa_vector> columns;
+	fill(columns);
+	std::size_t const size = decltype(columns)::columns;
+
+	auto const report = [&](char const* benchmark, char const* variant, auto f, auto const& values) {
+		double sum = 0;
+		double const ns = vta_benchmark::nanoseconds_per_call([&] {
+			sum = f(values);
+			vta_benchmark::do_not_optimize(sum);
+		}, 16);
+		vta_benchmark::report(benchmark, variant, size, "ns_per_record", ns / static_cast<double>(records));
+	};
+
+	report(column_benchmark, "vector_of_tuples", [](auto const& v) { return sum_column<I>(v); }, tuples);
+	report(column_benchmark, "soa_vector", [](auto const& v) { return sum_column<I>(v); }, columns);
+	report(product_benchmark, "vector_of_tuples", [](auto const& v) { return sum_product<I, J>(v); }, tuples);
+	report(product_benchmark, "soa_vector", [](auto const& v) { return sum_product<I, J>(v); }, columns);
+}
+
+}
+
+int main() {
+	compare<orders, 1, 2>("orders_sum_price", "orders_notional");
+	compare<quotes, 1, 3>("quotes_sum_bid", "quotes_bid_notional");
+}
@@ -0,0 +1,97 @@
+// Runtime benchmark of vta::sort and vta::median against std::sort and std::nth_element on a
+// std::array
+//
+// Each call sorts, or finds the median of, a small group of pseudo-random values taken from a pool
+// that is too large for the branch predictor to learn. std::sort and std::nth_element branch on
+// every comparison, while the sorting networks of vta::sort and vta::median compare and exchange
+// with a min and a max that compile to conditional moves.
+//
+// usage: sort_benchmark
+
+#include "benchmark.hpp"
+
+#include "vta/algorithms.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Cycles through a pool of pseudo-random groups of N values
+template <typename T, std::size_t N>
+class groups {
+	std::vector<std::array<T, N>> mGroups;
+	std::size_t mNext;
+
+public:
+	groups()
+	: mGroups(4096)
+	, mNext(0) {
+		std::uint32_t state = 12345;
+		for(auto& group : mGroups) {
+			for(T& x : group) {
+				state = state * 1664525u + 1013904223u;
+				x = static_cast<T>(state >> 8);
+			}
+		}
+	}
+
+	std::array<T, N> const& next() {
+		std::array<T, N> const& group = mGroups[mNext];
+		mNext = (mNext + 1) % mGroups.size();
+		return group;
+	}
+};
+
+template <typename T, std::size_t... Is>
+void compare(char const* sort_benchmark, char const* median_benchmark, std::index_sequence<Is...>) {
+	std::size_t const size = sizeof...(Is);
+
+	groups<T, size> std_sort_groups;
+	vta_benchmark::report(sort_benchmark, "std_sort", size, vta_benchmark::nanoseconds_per_call([&] {
+		std::array<T, size> values = std_sort_groups.next();
+		std::sort(values.begin(), values.end());
+		vta_benchmark::do_not_optimize(values);
+	}));
+
+	groups<T, size> sort_groups;
+	vta_benchmark::report(sort_benchmark, "vta_sort", size, vta_benchmark::nanoseconds_per_call([&] {
+		std::array<T, size> const& group = sort_groups.next();
+		std::array<T, size> const values = vta::sort(group[Is]...);
+		vta_benchmark::do_not_optimize(values);
+	}));
+
+	groups<T, size> nth_element_groups;
+	vta_benchmark::report(median_benchmark, "std_nth_element", size, vta_benchmark::nanoseconds_per_call([&] {
+		std::array<T, size> values = nth_element_groups.next();
+		std::nth_element(values.begin(), values.begin() + size / 2, values.end());
+		vta_benchmark::do_not_optimize(values[size / 2]);
+	}));
+
+	groups<T, size> median_groups;
+	vta_benchmark::report(median_benchmark, "vta_median", size, vta_benchmark::nanoseconds_per_call([&] {
+		std::array<T, size> const& group = median_groups.next();
+		T const median = vta::median(group[Is]...);
+		vta_benchmark::do_not_optimize(median);
+	}));
+}
+
+template <typename T>
+void compare_sizes(char const* sort_benchmark, char const* median_benchmark) {
+	compare<T>(sort_benchmark, median_benchmark, std::make_index_sequence<3>{});
+	compare<T>(sort_benchmark, median_benchmark, std::make_index_sequence<5>{});
+	compare<T>(sort_benchmark, median_benchmark, std::make_index_sequence<8>{});
+	compare<T>(sort_benchmark, median_benchmark, std::make_index_sequence<9>{});
+	compare<T>(sort_benchmark, median_benchmark, std::make_index_sequence<16>{});
+}
+
+}
+
+int main() {
+	compare_sizes<std::int32_t>("sort_int32", "median_int32");
+	compare_sizes<double>("sort_double", "median_double");
+}
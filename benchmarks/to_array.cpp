@@ -0,0 +1,77 @@
+// Runtime benchmark of vta::to_array and vta::to_span_of_refs against vta::map
+//
+// Each call computes the sum of squares of the fields of a record held in a std::tuple, whose
+// fields are not laid out in order. map calls the function once per field, to_array gathers the
+// fields into contiguous storage first and then loops over it, and to_span_of_refs loops over an
+// array of references to the fields where they are.
+//
+// usage: to_array_benchmark
+
+#include "benchmark.hpp"
+
+#include "vta/array.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <tuple>
+#include <utility>
+
+namespace {
+
+template <typename T>
+struct add_square {
+	T* sum;
+
+	void operator()(T value) const {
+		*sum += value * value;
+	}
+};
+
+template <std::size_t I, typename T>
+using always = T;
+
+template <typename T, std::size_t... Is>
+void compare(char const* benchmark, std::index_sequence<Is...>) {
+	std::size_t const size = sizeof...(Is);
+	std::tuple<always<Is, T>...> record{static_cast<T>(Is)...};
+
+	vta_benchmark::report(benchmark, "map", size, vta_benchmark::nanoseconds_per_call([&] {
+		vta_benchmark::clobber(record);
+		T sum = 0;
+		vta::map(add_square<T>{&sum})(std::get<Is>(record)...);
+		vta_benchmark::do_not_optimize(sum);
+	}));
+
+	vta_benchmark::report(benchmark, "to_array", size, vta_benchmark::nanoseconds_per_call([&] {
+		vta_benchmark::clobber(record);
+		T sum = 0;
+		for(T value : vta::to_array(std::get<Is>(record)...)) {
+			sum += value * value;
+		}
+		vta_benchmark::do_not_optimize(sum);
+	}));
+
+	vta_benchmark::report(benchmark, "to_span_of_refs", size, vta_benchmark::nanoseconds_per_call([&] {
+		vta_benchmark::clobber(record);
+		T sum = 0;
+		for(T const& value : vta::to_span_of_refs(std::get<Is>(record)...)) {
+			sum += value * value;
+		}
+		vta_benchmark::do_not_optimize(sum);
+	}));
+}
+
+template <typename T>
+void compare_sizes(char const* benchmark) {
+	compare<T>(benchmark, std::make_index_sequence<8>{});
+	compare<T>(benchmark, std::make_index_sequence<32>{});
+	compare<T>(benchmark, std::make_index_sequence<128>{});
+}
+
+}
+
+int main() {
+	compare_sizes<std::int32_t>("sum_squares_int32");
+	compare_sizes<double>("sum_squares_double");
+}
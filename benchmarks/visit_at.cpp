@@ -0,0 +1,142 @@
+// Runtime benchmark of vta::visit_at and vta::runtime_at against an if-chain over vta::at
+//
+// Each call visits one field of a decoded record chosen by an index that is only known at runtime.
+// The if-chain compares the index against each position in turn, visit_at makes one indirect call
+// through a table of function pointers and runtime_at indexes an array of pointers. The indices
+// are pseudo-random so that the branches in the if-chain cannot all be predicted.
+//
+// usage: visit_at_benchmark
+
+#include "benchmark.hpp"
+
+#include "vta/algorithms.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace {
+
+struct accumulate {
+	double* sum;
+
+	template <typename T>
+	void operator()(T const& value) const {
+		*sum += static_cast<double>(value);
+	}
+};
+
+// What code without visit_at looks like: try each position in turn
+template <std::size_t I, typename Function, typename... Args>
+void visit_if_chain(std::size_t, Function&, std::integral_constant<std::size_t, I>, std::true_type,
+                    Args const&...) {
+}
+
+template <std::size_t I, typename Function, typename... Args>
+void visit_if_chain(std::size_t i, Function& f, std::integral_constant<std::size_t, I>, std::false_type,
+                    Args const&... args) {
+	if(i == I) {
+		f(vta::at<I>(args...));
+	} else {
+		visit_if_chain(i, f, std::integral_constant<std::size_t, I + 1>{},
+		               std::integral_constant<bool, I + 1 == sizeof...(Args)>{}, args...);
+	}
+}
+
+template <typename Function, typename... Args>
+void visit_if_chain(std::size_t i, Function& f, Args const&... args) {
+	visit_if_chain(i, f, std::integral_constant<std::size_t, 0>{}, std::false_type{}, args...);
+}
+
+// Cycles through a fixed sequence of pseudo-random indices below size
+class indices {
+	std::vector<std::size_t> mIndices;
+	std::size_t mNext;
+
+public:
+	explicit indices(std::size_t size)
+	: mIndices(4096)
+	, mNext(0) {
+		std::uint32_t state = 12345;
+		for(std::size_t& i : mIndices) {
+			state = state * 1664525u + 1013904223u;
+			i = (state >> 8) % size;
+		}
+	}
+
+	std::size_t next() {
+		std::size_t const i = mIndices[mNext];
+		mNext = (mNext + 1) % mIndices.size();
+		return i;
+	}
+};
+
+// Alternates the types of the fields between int, double and std::int64_t
+template <std::size_t I>
+using field = std::conditional_t<I % 3 == 0, int, std::conditional_t<I % 3 == 1, double, std::int64_t>>;
+
+template <std::size_t... Is>
+void compare_mixed(std::index_sequence<Is...>) {
+	std::size_t const size = sizeof...(Is);
+	std::tuple<field<Is>...> record{static_cast<field<Is>>(Is)...};
+	double sum = 0;
+	accumulate f{&sum};
+
+	indices chain_indices{size};
+	vta_benchmark::report("visit_mixed", "if_chain", size, vta_benchmark::nanoseconds_per_call([&] {
+		vta_benchmark::clobber(record);
+		visit_if_chain(chain_indices.next(), f, std::get<Is>(record)...);
+		vta_benchmark::do_not_optimize(sum);
+	}));
+
+	indices visit_indices{size};
+	vta_benchmark::report("visit_mixed", "visit_at", size, vta_benchmark::nanoseconds_per_call([&] {
+		vta_benchmark::clobber(record);
+		vta::visit_at(visit_indices.next(), f, std::get<Is>(record)...);
+		vta_benchmark::do_not_optimize(sum);
+	}));
+}
+
+template <std::size_t... Is>
+void compare_homogeneous(std::index_sequence<Is...>) {
+	std::size_t const size = sizeof...(Is);
+	std::array<double, size> values{{static_cast<double>(Is)...}};
+	double sum = 0;
+	accumulate f{&sum};
+
+	indices chain_indices{size};
+	vta_benchmark::report("visit_double", "if_chain", size, vta_benchmark::nanoseconds_per_call([&] {
+		vta_benchmark::clobber(values);
+		visit_if_chain(chain_indices.next(), f, values[Is]...);
+		vta_benchmark::do_not_optimize(sum);
+	}));
+
+	indices visit_indices{size};
+	vta_benchmark::report("visit_double", "visit_at", size, vta_benchmark::nanoseconds_per_call([&] {
+		vta_benchmark::clobber(values);
+		vta::visit_at(visit_indices.next(), f, values[Is]...);
+		vta_benchmark::do_not_optimize(sum);
+	}));
+
+	indices runtime_indices{size};
+	vta_benchmark::report("visit_double", "runtime_at", size, vta_benchmark::nanoseconds_per_call([&] {
+		vta_benchmark::clobber(values);
+		f(vta::runtime_at(runtime_indices.next(), values[Is]...));
+		vta_benchmark::do_not_optimize(sum);
+	}));
+}
+
+}
+
+int main() {
+	compare_mixed(std::make_index_sequence<8>{});
+	compare_mixed(std::make_index_sequence<32>{});
+	compare_mixed(std::make_index_sequence<128>{});
+	compare_homogeneous(std::make_index_sequence<8>{});
+	compare_homogeneous(std::make_index_sequence<32>{});
+	compare_homogeneous(std::make_index_sequence<128>{});
+}
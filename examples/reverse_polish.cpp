@@ -24,35 +24,35 @@ static constexpr fact_type fact{};
 
 template <typename T, typename std::enable_if<std::is_arithmetic<T>::value>* = nullptr>
 struct polish_calculator {
-	constexpr T operator()(std::pair<T, T> stack, add_type) noexcept {
+	constexpr T operator()(std::pair<T, T> stack, add_type) const noexcept {
 		return stack.first + stack.second;
 	}
 
-	constexpr T operator()(std::pair<T, T> stack, minus_type) noexcept {
+	constexpr T operator()(std::pair<T, T> stack, minus_type) const noexcept {
 		return stack.first - stack.second;
 	}
 
-	constexpr T operator()(std::pair<T, T> stack, mult_type) noexcept {
+	constexpr T operator()(std::pair<T, T> stack, mult_type) const noexcept {
 		return stack.first * stack.second;
 	}
 
-	constexpr T operator()(std::pair<T, T> stack, div_type) noexcept {
+	constexpr T operator()(std::pair<T, T> stack, div_type) const noexcept {
 		return stack.first / stack.second;
 	}
 
 	// Only allow factorial if the type is integral (e.g. disable for double)
 	// This function can only throw if T is signed, so mark as noexcept otherwise
-	constexpr auto operator()(T stack, fact_type) noexcept(std::is_unsigned<T>::value)
+	constexpr auto operator()(T stack, fact_type) const noexcept(std::is_unsigned<T>::value)
 	  -> typename std::enable_if<std::is_integral<T>::value, T>::type {
 		return (stack < 0) ? throw std::runtime_error{"Negative value passed to factorial"}
 		                   : (stack == 0) ? 1 : stack * (*this)(stack - 1, fact);
 	}
 
-	constexpr std::pair<T, T> operator()(T first, T second) noexcept {
+	constexpr std::pair<T, T> operator()(T first, T second) const noexcept {
 		return {first, second};
 	}
 
-	constexpr T operator()(start_type, T second) noexcept {
+	constexpr T operator()(start_type, T second) const noexcept {
 		return second;
 	}
 };
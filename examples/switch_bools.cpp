@@ -34,4 +34,13 @@ int main() {
 	}
 
 	std::cout << std::endl;
+
+	// The same without a case for every combination: each flag arrives as a std::true_type or
+	// std::false_type, so the lambda is compiled separately for each of the 8 combinations
+	vta::dispatch_bools([](auto... flags) {
+		char const letters[] = {(flags ? 'T' : 'F')..., '\0'};
+		std::cout << letters;
+	}, a, b, c);
+
+	std::cout << std::endl;
 }
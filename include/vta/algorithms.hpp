@@ -30,9 +30,22 @@
 #ifndef INCLUDE_GUARD_12E75493_BA12_4EF3_B0D8_92747A030D0E
 #define INCLUDE_GUARD_12E75493_BA12_4EF3_B0D8_92747A030D0E
 
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <tuple>
 #include <type_traits>
 #include <utility>
 
+// map, foldl, foldr, all_of, any_of and none_of are single fold expressions when the compiler has
+// them, and recurse over the parameter pack otherwise. Defining VTA_NO_FOLD_EXPRESSIONS selects the
+// recursive versions on every compiler.
+#if defined(__cpp_fold_expressions) && !defined(VTA_NO_FOLD_EXPRESSIONS)
+#define VTA_DETAIL_FOLD_EXPRESSIONS
+#endif
+
 namespace vta {
 
 // Returns the size of the parameter pack as an integer
@@ -53,69 +66,107 @@ constexpr int count(Args&&...) noexcept {
  * Predicates                                                                                     *
  **************************************************************************************************/
 
-/** are_same */
+namespace detail {
+
 template <typename... Args>
-struct are_same;
+struct type_list {
+	static std::size_t const size = sizeof...(Args);
+};
 
-template <typename First, typename Second, typename... Args>
-struct are_same<First, Second, Args...> {
-	static bool const value = std::is_same<First, Second>::value
-	                       && are_same<Second, Args...>::value;
+template <bool... Bs>
+struct bool_list {};
+
+// Whether all of Bs are true, which is exactly when shifting them along by one changes nothing
+template <bool... Bs>
+struct all_true {
+	static bool const value = std::is_same<bool_list<true, Bs...>, bool_list<Bs..., true>>::value;
 };
 
-template <typename Arg>
-struct are_same<Arg> : public std::true_type {};
+template <typename T>
+struct type_key {};
 
-template <>
-struct are_same<> : public std::true_type {};
+template <std::size_t I, typename T>
+struct indexed_key : type_key<T> {};
 
-/** are_same_after */
-template <template<class> class TypeTransformation, typename... Args>
-struct are_same_after {
-	static bool const value = vta::are_same<typename TypeTransformation<Args>::type...>::value;
-};
+// Derives from type_key<T> once for each time that T appears in Args, so a type_set converts to
+// type_key<T> only if T appears exactly once and is otherwise an ambiguous base
+template <typename Indices, typename... Args>
+struct type_set;
 
-/** are_unique_ints */
-template <int... Ns>
-struct are_unique_ints;
+template <std::size_t... Is, typename... Args>
+struct type_set<std::index_sequence<Is...>, Args...> : indexed_key<Is, Args>... {};
 
-template <>
-struct are_unique_ints<> {
-	static bool const value = true;
+template <typename T>
+struct type_tag {
+	typedef T type;
 };
 
-template <int N>
-struct are_unique_ints<N> {
-	static bool const value = true;
-};
+// Moves values[i] down the max-heap held in values[0], ..., values[size - 1] until it is no smaller
+// than its children
+constexpr void sift_down(int* values, std::size_t i, std::size_t size) noexcept {
+	for(std::size_t child = 2 * i + 1; child < size; child = 2 * i + 1) {
+		if(child + 1 < size && values[child] < values[child + 1]) {
+			++child;
+		}
+		if(!(values[i] < values[child])) {
+			return;
+		}
+		int const value = values[i];
+		values[i] = values[child];
+		values[child] = value;
+		i = child;
+	}
+}
 
-template <int M, int N, int... Ns>
-struct are_unique_ints<M, N, Ns...> {
-	static bool const value = (M != N)
-	                        && are_unique_ints<M, Ns...>::value
-	                        && are_unique_ints<N, Ns...>::value;
-};
+// Heap sorts a copy of Ns... and compares neighbours, which takes O(N log N) steps
+template <int... Ns>
+constexpr bool are_unique_values() noexcept {
+	int values[] = {Ns..., 0};
+	std::size_t const size = sizeof...(Ns);
+	for(std::size_t i = size / 2; i-- > 0;) {
+		sift_down(values, i, size);
+	}
+	for(std::size_t end = size; end > 1; --end) {
+		int const largest = values[0];
+		values[0] = values[end - 1];
+		values[end - 1] = largest;
+		sift_down(values, 0, end - 1);
+	}
+	for(std::size_t i = 1; i < size; ++i) {
+		if(values[i - 1] == values[i]) {
+			return false;
+		}
+	}
+	return true;
+}
 
-/** are_unique */
+} // namespace detail
+
+/** are_same */
 template <typename... Args>
-struct are_unique;
+struct are_same : public std::true_type {};
 
-template <>
-struct are_unique<> {
-	static bool const value = true;
-};
+template <typename First, typename... Args>
+struct are_same<First, Args...>
+: public std::integral_constant<bool, std::is_same<detail::type_list<First, Args...>,
+                                                   detail::type_list<Args..., First>>::value> {};
 
-template <typename Arg>
-struct are_unique<Arg> {
-	static bool const value = true;
+/** are_same_after */
+template <template<class> class TypeTransformation, typename... Args>
+struct are_same_after {
+	static bool const value = vta::are_same<typename TypeTransformation<Args>::type...>::value;
 };
 
-template <typename Arg1, typename Arg2, typename... Args>
-struct are_unique<Arg1, Arg2, Args...> {
-	static bool const value = (!std::is_same<Arg1, Arg2>::value)
-	                        && are_unique<Arg1, Args...>::value
-	                        && are_unique<Arg2, Args...>::value;
-};
+/** are_unique_ints */
+template <int... Ns>
+struct are_unique_ints : public std::integral_constant<bool, detail::are_unique_values<Ns...>()> {};
+
+/** are_unique */
+template <typename... Args>
+struct are_unique
+: public std::integral_constant<bool, detail::all_true<
+    std::is_convertible<detail::type_set<std::index_sequence_for<Args...>, Args...>*,
+                        detail::type_key<Args>*>::value...>::value> {};
 
 /** are_unique_after */
 template <template<class> class TypeTransformation, typename... Args>
@@ -134,18 +185,19 @@ public:
 	}
 
 	template <typename... Args>
-	constexpr auto operator()(Args&&... args) const {
+	constexpr decltype(auto) operator()(Args&&... args) const {
 		return Transformation::transform(mF, std::forward<Args>(args)...);
 	}
 
 	template <typename... Args>
-	auto operator()(Args&&... args) {
+	decltype(auto) operator()(Args&&... args) {
 		return Transformation::transform(mF, std::forward<Args>(args)...);
 	}
 };
 
 template <typename Transformation, typename Function>
-constexpr forward_after_f<Function, Transformation> forward_after(Function&& f) {
+constexpr forward_after_f<typename std::remove_reference<Function>::type, Transformation>
+forward_after(Function&& f) {
 	return {std::forward<Function>(f)};
 }
 
@@ -155,26 +207,94 @@ constexpr forward_after_f<Function, Transformation> forward_after(Function&& f)
 
 namespace detail {
 
+// A reference to the argument at position I of a forward_pack
+template <std::size_t I, typename Arg>
+struct forward_leaf {
+	Arg&& value;
+};
+
+// Holds a reference to each argument in a flat hierarchy so that any argument can be retrieved by
+// position in constant depth, rather than by recursing through the arguments before it.
+template <typename Indices, typename... Args>
+struct forward_pack;
+
+template <std::size_t... Is, typename... Args>
+struct forward_pack<std::index_sequence<Is...>, Args...> : forward_leaf<Is, Args>... {
+	constexpr forward_pack(Args&&... args) noexcept
+	: forward_leaf<Is, Args>{std::forward<Args>(args)}... {
+	}
+};
+
+template <std::size_t I, typename Arg>
+constexpr Arg&& get(forward_leaf<I, Arg> const& leaf) noexcept {
+	return std::forward<Arg>(leaf.value);
+}
+
+// Calls f with the arguments at each of Positions, in that order, in a single call.
+template <typename Positions>
+struct forward_positions;
+
+template <std::size_t... Positions>
+struct forward_positions<std::index_sequence<Positions...>> {
+	template <typename Function, typename... Args>
+	constexpr static decltype(auto) transform(Function&& f, Args&&... args) {
+		forward_pack<std::index_sequence_for<Args...>, Args...> const pack{std::forward<Args>(args)...};
+		return std::forward<Function>(f)(get<Positions>(pack)...);
+	}
+};
+
+// Normalizes N, which may be negative, to an index into a pack of Size arguments
+template <int N, int Size>
+struct pack_index {
+	static_assert(-Size <= N && N < Size, "N is out of bounds");
+	static std::size_t const value = Size == 0 ? 0 : (N + Size) % Size;
+};
+
+// index_sequence<Map::at(0), Map::at(1), ..., Map::at(Map::size - 1)>
+template <typename Map, typename Indices = std::make_index_sequence<Map::size>>
+struct generate_positions;
+
+template <typename Map, std::size_t... Is>
+struct generate_positions<Map, std::index_sequence<Is...>> {
+	typedef std::index_sequence<Map::at(Is)...> type;
+};
+
+struct positional_tag {};
+
+// Base of transformations that only reorder or select arguments. For the argument types Args...,
+// Transformation::positions<Args...> has a static member size, the number of arguments forwarded,
+// and a constexpr function at(i), the position in Args... of the i-th argument forwarded. However
+// the positions are computed, the arguments are forwarded to f in a single call.
+template <typename Transformation>
+struct positional : positional_tag {
+	template <typename Function, typename... Args>
+	constexpr static decltype(auto) transform(Function&& f, Args&&... args) {
+		typedef typename Transformation::template positions<Args...> Map;
+		return forward_positions<typename generate_positions<Map>::type>
+		  ::transform(std::forward<Function>(f), std::forward<Args>(args)...);
+	}
+};
+
+}
+
+namespace detail {
+
 template <typename Function, typename... Transforms>
 class compose_helper_f;
 
+// Applies FirstTransform and then Transforms... before calling f. Each stage refers to the same f,
+// so f is not copied however many stages there are.
 template <typename Function, typename FirstTransform, typename... Transforms>
 class compose_helper_f<Function, FirstTransform, Transforms...> {
-	Function mF;
+	Function& mF;
 
 public:
-	constexpr compose_helper_f(Function f)
-	: mF(std::move(f)) {
-	}
-
-	template <typename... Args>
-	constexpr auto operator()(Args&&... args) const {
-		return FirstTransform::transform(compose_helper_f<Function, Transforms...>{mF},
-		                                 std::forward<Args>(args)...);
+	constexpr compose_helper_f(Function& f) noexcept
+	: mF(f) {
 	}
 
 	template <typename... Args>
-	auto operator()(Args&&... args) {
+	constexpr decltype(auto) operator()(Args&&... args) const {
 		return FirstTransform::transform(compose_helper_f<Function, Transforms...>{mF},
 		                                 std::forward<Args>(args)...);
 	}
@@ -182,40 +302,109 @@ public:
 
 template <typename Function>
 class compose_helper_f<Function> {
-	Function mF;
+	Function& mF;
 
 public:
-	compose_helper_f(Function f)
-	: mF(std::move(f)) {
+	constexpr compose_helper_f(Function& f) noexcept
+	: mF(f) {
 	}
 
 	template <typename... Args>
-	constexpr auto operator()(Args&&... args) const {
+	constexpr decltype(auto) operator()(Args&&... args) const {
 		return mF(std::forward<Args>(args)...);
 	}
+};
 
-	template <typename... Args>
-	auto operator()(Args&&... args) {
-		return mF(std::forward<Args>(args)...);
+// Applies each of Transforms in turn, each one wrapping f in the functor that applies the rest
+template <typename... Transforms>
+struct nested_compose {
+	template <typename Function, typename... Args>
+	constexpr static decltype(auto) transform(Function&& f, Args&&... args) {
+		typedef compose_helper_f<typename std::remove_reference<Function>::type, Transforms...> Helper;
+		return Helper{f}(std::forward<Args>(args)...);
 	}
 };
 
+template <std::size_t I, typename T>
+type_tag<T> select_type(indexed_key<I, T>*);
+
+// The type at position I of Args...
+template <std::size_t I, typename... Args>
+using type_at_position = typename decltype(
+  select_type<I>(static_cast<type_set<std::index_sequence_for<Args...>, Args...>*>(nullptr)))::type;
+
+// Next::positions for the types in Args... at each of Positions
+template <typename Next, typename Positions, typename... Args>
+struct positions_after;
+
+template <typename Next, std::size_t... Positions, typename... Args>
+struct positions_after<Next, std::index_sequence<Positions...>, Args...> {
+	typedef typename Next::template positions<type_at_position<Positions, Args...>...> type;
+};
+
+// The positions of a chain of positional transformations, where the i-th argument forwarded is at
+// First::at(Rest::at(i)). Each transformation after the first is given the types that the ones
+// before it would forward, as filter depends on them.
+template <typename... Transforms>
+struct compose_positions;
+
+template <>
+struct compose_positions<> {
+	template <typename... Args>
+	struct positions {
+		static std::size_t const size = sizeof...(Args);
+
+		constexpr static std::size_t at(std::size_t i) noexcept {
+			return i;
+		}
+	};
+};
+
+template <typename Transform>
+struct compose_positions<Transform> {
+	template <typename... Args>
+	using positions = typename Transform::template positions<Args...>;
+};
+
+template <typename First, typename Second, typename... Rest>
+struct compose_positions<First, Second, Rest...> {
+	template <typename... Args>
+	struct positions {
+		typedef typename First::template positions<Args...> first;
+		typedef typename positions_after<compose_positions<Second, Rest...>,
+		                                 typename generate_positions<first>::type,
+		                                 Args...>::type rest;
+		static std::size_t const size = rest::size;
+
+		constexpr static std::size_t at(std::size_t i) noexcept {
+			return first::at(rest::at(i));
+		}
+	};
+};
+
+template <typename... Transforms>
+struct is_positional_chain : all_true<std::is_base_of<positional_tag, Transforms>::value...> {};
+
 }
 
-/** Composes a sequence of transformations. */
+/** Composes a sequence of transformations. If they are all positional, the positions they select
+    are worked out at compile time and the arguments are forwarded to f in a single call. */
 template <typename... Transforms>
-struct compose {
-	template <typename Function, typename... Args>
-	constexpr static auto transform(Function&& f, Args&&... args) {
-		typedef detail::compose_helper_f<typename std::remove_reference<Function>::type, Transforms...> Helper;
-		return Helper{f}(std::forward<Args>(args)...);
-	}
+struct compose : std::conditional_t<detail::is_positional_chain<Transforms...>::value,
+                                    detail::positional<compose<Transforms...>>,
+                                    detail::nested_compose<Transforms...>> {
+	template <typename... Args>
+	using positions = typename detail::compose_positions<Transforms...>::template positions<Args...>;
 };
 
 /** Forwards the arguments to f without change. */
-struct id {
+struct id : detail::positional<id> {
+	template <typename... Args>
+	using positions = typename detail::compose_positions<>::template positions<Args...>;
+
+	// Calls f directly rather than through a forward_pack, as there is nothing to reorder
 	template <typename Function, typename... Args>
-	constexpr static auto transform(Function&& f, Args&&... args) {
+	constexpr static decltype(auto) transform(Function&& f, Args&&... args) {
 		return std::forward<Function>(f)(std::forward<Args>(args)...);
 	}
 };
@@ -227,7 +416,7 @@ struct call_if;
 template <>
 struct call_if<true> {
 	template <typename Function, typename... Args>
-	constexpr static auto transform(Function&& f, Args&&... args) {
+	constexpr static decltype(auto) transform(Function&& f, Args&&... args) {
 		return id::transform(std::forward<Function>(f), std::forward<Args>(args)...);
 	}
 };
@@ -240,240 +429,166 @@ struct call_if<false> {
 };
 
 /** Flips the first two variables. */
-struct flip {
-	template <typename Function, typename First, typename Second, typename... Args>
-	constexpr static auto transform(Function&& f, First&& first, Second&& second, Args&&... rest) {
-		return std::forward<Function>(f)(std::forward<Second>(second),
-		                                 std::forward<First>(first),
-		                                 std::forward<Args>(rest)...);
-	}
+struct flip : detail::positional<flip> {
+	template <typename... Args>
+	struct positions {
+		static_assert(sizeof...(Args) >= 2, "flip needs at least two arguments");
+		static std::size_t const size = sizeof...(Args);
+
+		constexpr static std::size_t at(std::size_t i) noexcept {
+			return i < 2 ? 1 - i : i;
+		}
+	};
+};
+
+/** Forwards only the arguments at positions Ns..., in that order. If a position is negative, it is
+    counted from the end of the parameter pack. */
+template <int... Ns>
+struct permute : detail::positional<permute<Ns...>> {
+	template <typename... Args>
+	struct positions {
+		static_assert(vta::are_unique_ints<detail::pack_index<Ns, sizeof...(Args)>::value...>::value,
+		  "The positions to permute must be unique");
+		static std::size_t const size = sizeof...(Ns);
+
+		constexpr static std::size_t at(std::size_t i) noexcept {
+			std::size_t const ns[] = {detail::pack_index<Ns, sizeof...(Args)>::value..., 0};
+			return ns[i];
+		}
+	};
 };
 
 /** Left cyclic shifts the parameters \a n places. */
 template <unsigned N>
-struct left_shift {
-	template <typename Function, typename First, typename... Args>
-	constexpr static auto transform(Function&& f, First&& first, Args&&... rest) {
-		static_assert(N < 1 + sizeof...(rest),
+struct left_shift : detail::positional<left_shift<N>> {
+	template <typename... Args>
+	struct positions {
+		static_assert(N == 0 || N < sizeof...(Args),
 		  "Cannot left shift more than the size of the parameter pack");
-		return left_shift<N - 1>::transform(std::forward<Function>(f),
-		                                    std::forward<Args>(rest)...,
-		                                    std::forward<First>(first));
-	}
-};
+		static std::size_t const size = sizeof...(Args);
 
-template <>
-struct left_shift<0u> {
-	template <typename Function, typename... Args>
-	constexpr static auto transform(Function&& f, Args&&... rest) {
-		return id::transform(std::forward<Function>(f), std::forward<Args>(rest)...);
-	}
+		constexpr static std::size_t at(std::size_t i) noexcept {
+			return (i + N) % size;
+		}
+	};
 };
 
 /** Right cyclic shifts the parameters \a n places. */
 template <unsigned N>
-struct right_shift {
-	template <typename Function, typename... Args>
-	constexpr static auto transform(Function&& f, Args&&... args) {
-		static_assert(N < sizeof...(args),
+struct right_shift : detail::positional<right_shift<N>> {
+	template <typename... Args>
+	struct positions {
+		static_assert(N == 0 || N < sizeof...(Args),
 		  "Cannot right shift more than the size of the parameter pack");
-		return left_shift<sizeof...(Args) - N>::transform(std::forward<Function>(f),
-		                                                  std::forward<Args>(args)...);
-	}
-};
+		static std::size_t const size = sizeof...(Args);
 
-template <>
-struct right_shift<0u> {
-	template <typename Function, typename... Args>
-	constexpr static auto transform(Function&& f, Args&&... rest) {
-		return id::transform(std::forward<Function>(f), std::forward<Args>(rest)...);
-	}
+		constexpr static std::size_t at(std::size_t i) noexcept {
+			return (i + size - N) % size;
+		}
+	};
 };
 
 template <int N, bool NotNegative = (N >= 0)>
 struct shift;
 
 template <int N>
-struct shift<N, true> {
-	template <typename Function, typename... Args>
-	constexpr static auto transform(Function&& f, Args&&... args) {
-		return left_shift<N>::transform(std::forward<Function>(f),
-		                                std::forward<Args>(args)...);
-	}
+struct shift<N, true> : left_shift<N> {
 };
 
 template <int N>
-struct shift<N, false> {
-	template <typename Function, typename... Args>
-	constexpr static auto transform(Function&& f, Args&&... args) {
-		return right_shift<-N>::transform(std::forward<Function>(f),
-		                                  std::forward<Args>(args)...);
-	}
+struct shift<N, false> : right_shift<-N> {
 };
 
 /** Left cyclic shifts the tail of the parameters \a n places. */
 template <unsigned N>
-struct left_shift_tail {
-	template <typename Function, typename Fixed, typename First, typename... Args>
-	constexpr static auto transform(Function&& f, Fixed&& fixed, First&& first, Args&&... rest) {
-		static_assert(N < 1 + sizeof...(rest),
+struct left_shift_tail : detail::positional<left_shift_tail<N>> {
+	template <typename... Args>
+	struct positions {
+		static_assert(N == 0 || N + 1 < sizeof...(Args),
 		  "Cannot left shift more than the size of the tail of the parameter pack");
-		return left_shift_tail<N - 1>::transform(std::forward<Function>(f),
-		                                         std::forward<Fixed>(fixed),
-		                                         std::forward<Args>(rest)...,
-		                                         std::forward<First>(first));
-	}
-};
+		static std::size_t const size = sizeof...(Args);
 
-template <>
-struct left_shift_tail<0u> {
-	template <typename Function, typename... Args>
-	constexpr static auto transform(Function&& f, Args&&... rest) {
-		return id::transform(std::forward<Function>(f), std::forward<Args>(rest)...);
-	}
+		constexpr static std::size_t at(std::size_t i) noexcept {
+			return i == 0 ? 0 : 1 + (i - 1 + N) % (size - 1);
+		}
+	};
 };
 
 /** Right cyclic shifts the tail of the parameters \a n places. */
 template <unsigned N>
-struct right_shift_tail {
-	template <typename Function, typename... Args>
-	constexpr static auto transform(Function&& f, Args&&... args) {
-		static_assert(N < sizeof...(args) - 1,
+struct right_shift_tail : detail::positional<right_shift_tail<N>> {
+	template <typename... Args>
+	struct positions {
+		static_assert(N == 0 || N + 1 < sizeof...(Args),
 		  "Cannot right shift more than the size of the tail of the parameter pack");
-		return left_shift_tail<sizeof...(Args) - N - 1>::transform(std::forward<Function>(f),
-		                                                           std::forward<Args>(args)...);
-	}
-};
+		static std::size_t const size = sizeof...(Args);
 
-template <>
-struct right_shift_tail<0u> {
-	template <typename Function, typename... Args>
-	constexpr static auto transform(Function&& f, Args&&... rest) {
-		return id::transform(std::forward<Function>(f), std::forward<Args>(rest)...);
-	}
+		constexpr static std::size_t at(std::size_t i) noexcept {
+			return i == 0 ? 0 : 1 + (i - 1 + size - 1 - N) % (size - 1);
+		}
+	};
 };
 
 template <int N, bool NotNegative = (N >= 0)>
 struct shift_tail;
 
 template <int N>
-struct shift_tail<N, true> {
-	template <typename Function, typename... Args>
-	constexpr static auto transform(Function&& f, Args&&... args) {
-		return left_shift_tail<N>::transform(std::forward<Function>(f),
-		                                     std::forward<Args>(args)...);
-	}
+struct shift_tail<N, true> : left_shift_tail<N> {
 };
 
 template <int N>
-struct shift_tail<N, false> {
-	template <typename Function, typename... Args>
-	constexpr static auto transform(Function&& f, Args&&... args) {
-		return right_shift_tail<-N>::transform(std::forward<Function>(f),
-		                                       std::forward<Args>(args)...);
-	}
-};
-
-namespace detail {
-
-template <unsigned N>
-struct drop_helper {
-	template <typename Function, typename First, typename... Args>
-	constexpr static auto transform(Function&& f, First&&, Args&&... args) {
-		return drop_helper<N - 1>::transform(std::forward<Function>(f), std::forward<Args>(args)...);
-	}
-};
-
-template <>
-struct drop_helper<0u> {
-	template <typename Function, typename... Args>
-	constexpr static auto transform(Function&& f, Args&&... args) {
-		return id::transform(std::forward<Function>(f), std::forward<Args>(args)...);
-	}
+struct shift_tail<N, false> : right_shift_tail<-N> {
 };
 
-}
-
 /** Drops the first N arguments. */
 template <int N>
-struct drop {
-	template <typename Function, typename... Args>
-	constexpr static auto transform(Function&& f, Args&&... args) {
-		static_assert(-count(args...) <= N && N <= count(args...),
+struct drop : detail::positional<drop<N>> {
+	template <typename... Args>
+	struct positions {
+		static int const length = sizeof...(Args);
+		static_assert(-length <= N && N <= length,
 		  "Cannot drop more variables than are passed");
-		return detail::drop_helper<N < 0 ? N + count(args...) : N>::transform(std::forward<Function>(f), std::forward<Args>(args)...);
-	}
-};
+		static std::size_t const first = N < 0 ? N + length : N;
+		static std::size_t const size = length - first;
 
-namespace detail {
-
-template <unsigned N, bool ForwardAll>
-struct take_helper;
-
-template <unsigned N>
-struct take_helper<N, true> {
-	template <typename Function, typename... Args>
-	constexpr static auto transform(Function&& f, Args&&... args) {
-		return id::transform(std::forward<Function>(f), std::forward<Args>(args)...);
-	}
-};
-
-template <unsigned N>
-struct take_helper<N, false> {
-	template <typename Function, typename... Args>
-	constexpr static auto transform(Function&& f, Args&&... args) {
-		return compose<left_shift<N>,
-		               drop<sizeof...(args) - N>
-		              >::transform(std::forward<Function>(f), std::forward<Args>(args)...);
-	}
+		constexpr static std::size_t at(std::size_t i) noexcept {
+			return first + i;
+		}
+	};
 };
 
-}
-
 /** Passes only the first N arguments. */
 template <int N>
-struct take {
-	template <typename Function, typename... Args>
-	constexpr static auto transform(Function&& f, Args&&... args) {
-		static_assert(-count(args...) <= N && N <= count(args...), "Cannot take more parameters that are available");
-		return detail::take_helper<N < 0 ? N + count(args...) : N,
-		                           N == sizeof...(args)>::transform(std::forward<Function>(f),
-		                                                            std::forward<Args>(args)...);
-	}
-};
+struct take : detail::positional<take<N>> {
+	template <typename... Args>
+	struct positions {
+		static int const length = sizeof...(Args);
+		static_assert(-length <= N && N <= length, "Cannot take more parameters that are available");
+		static std::size_t const size = N < 0 ? N + length : N;
 
-template <>
-struct take<0u> {
-	template <typename Function, typename... Args>
-	constexpr static auto transform(Function&& f, Args&&...) {
-		return std::forward<Function>(f)();
-	}
+		constexpr static std::size_t at(std::size_t i) noexcept {
+			return i;
+		}
+	};
 };
 
 /** Take only the arguments at positions N, N + 1, ..., M - 1, M */
 template <int N, int M>
-struct slice {
-	template <typename Function, typename... Args>
-	constexpr static auto transform(Function&& f, Args&&... args) {
-		static_assert(-count(args...) <= N && N < count(args...),
+struct slice : detail::positional<slice<N, M>> {
+	template <typename... Args>
+	struct positions {
+		static int const length = sizeof...(Args);
+		static_assert(-length <= N && N < length,
 		  "N is out of bounds");
-		static_assert(-count(args...) <= M && M < count(args...),
+		static_assert(-length <= M && M < length,
 		  "M is out of bounds");
-		static int const A = (N + count(args...)) % count(args...);
-		static int const B = (M + count(args...)) % count(args...);
-		static_assert(A <= B, "N must be <= M");
-		static_assert(B <= count(args...), "M is out of bounds");
-		return m_slice<A, B>::transform(std::forward<Function>(f), std::forward<Args>(args)...);
-	}
+		static std::size_t const first = (N + length) % length;
+		static std::size_t const last = (M + length) % length;
+		static_assert(first <= last, "N must be <= M");
+		static std::size_t const size = last - first + 1;
 
-private:
-	template <unsigned A, unsigned B>
-	struct m_slice {
-		template <typename Function, typename... Args>
-		constexpr static auto transform(Function&& f, Args&&... args) {
-			return compose<left_shift<A>,
-			               drop<sizeof...(args) - (B - A)>
-			              >::transform(std::forward<Function>(f), std::forward<Args>(args)...);
+		constexpr static std::size_t at(std::size_t i) noexcept {
+			return first + i;
 		}
 	};
 };
@@ -481,196 +596,133 @@ private:
 /** Swap the parameters in the positions \a n and \a m. If a number is negative, it is counted from
     the end of the parameter pack. e.g. -1 would be the last parameter. */
 template <int N, int M>
-struct swap {
-	template <typename Function, typename... Args>
-	constexpr static auto transform(Function&& f, Args&&... args) {
-		static int const size = count(args...);
-		static_assert(-size <= N && N < size,
-		  "N is out of bounds");
-		static_assert(-size <= M && M < size,
-		  "M is out of bounds");
-		static int const A = (N + size) % size;
-		static int const B = (M + size) % size;
-		static int const min = A < B ? A : B;
-		static int const max = A < B ? B : A;
-		return swap_helper<min, max>::transform(std::forward<Function>(f), std::forward<Args>(args)...);
-	}
+struct swap : detail::positional<swap<N, M>> {
+	template <typename... Args>
+	struct positions {
+		static std::size_t const a = detail::pack_index<N, sizeof...(Args)>::value;
+		static std::size_t const b = detail::pack_index<M, sizeof...(Args)>::value;
+		static std::size_t const size = sizeof...(Args);
 
-private:
-	template <int Min, int Max>
-	struct swap_helper {
-		template <typename Function, typename... Args>
-		constexpr static auto transform(Function&& f, Args&&... args) {
-			return compose<shift<Min>,
-			               shift_tail<Max - Min - 1>,
-			               flip,
-			               shift_tail<-(Max - Min - 1)>,
-			               shift<-Min>
-			              >::transform(std::forward<Function>(f), std::forward<Args>(args)...);
+		constexpr static std::size_t at(std::size_t i) noexcept {
+			return i == a ? b : i == b ? a : i;
 		}
 	};
+};
 
-	template <int MinMax>
-	struct swap_helper<MinMax, MinMax> {
-		template <typename Function, typename... Args>
-		constexpr static auto transform(Function&& f, Args&&... args) {
-			return id::transform(std::forward<Function>(f), std::forward<Args>(args)...);
+/** Permutes the parameters at Positions... using cycle notation, i.e. the parameter at each
+    position moves to the next position and the last moves to the first. */
+template <int... Positions>
+struct cycle : detail::positional<cycle<Positions...>> {
+	template <typename... Args>
+	struct positions {
+		static_assert(vta::are_unique_ints<detail::pack_index<Positions, sizeof...(Args)>::value...>::value,
+		  "The positions to permute must be unique");
+		static std::size_t const size = sizeof...(Args);
+
+		constexpr static std::size_t at(std::size_t i) noexcept {
+			std::size_t const ps[] = {detail::pack_index<Positions, sizeof...(Args)>::value..., 0};
+			std::size_t const n = sizeof...(Positions);
+			for(std::size_t k = 0; k < n; ++k) {
+				if(ps[k] == i) {
+					return ps[(k + n - 1) % n];
+				}
+			}
+			return i;
 		}
 	};
 };
 
-namespace detail {
+/** Reverse the order of arguments */
+struct reverse : detail::positional<reverse> {
+	template <typename... Args>
+	struct positions {
+		static std::size_t const size = sizeof...(Args);
 
-template <int N, int Modulus>
-struct modulus {
-	static int const value = (N + Modulus) % Modulus;
+		constexpr static std::size_t at(std::size_t i) noexcept {
+			return size - 1 - i;
+		}
+	};
 };
 
-}
-
-template <int... Positions>
-struct cycle;
+namespace detail {
 
-template <>
-struct cycle<> {
-	template <typename Function, typename... Args>
-	constexpr static auto transform(Function&& f, Args&&... args) {
-		return id::transform(std::forward<Function>(f), std::forward<Args>(args)...);
-	}
+// values[0], ..., values[size - 1] are positions in a pack of N types
+template <std::size_t N>
+struct position_array {
+	std::size_t values[N + 1];
+	std::size_t size;
 };
 
-template <int First>
-struct cycle<First> {
-	template <typename Function, typename... Args>
-	constexpr static auto transform(Function&& f, Args&&... args) {
-		return id::transform(std::forward<Function>(f), std::forward<Args>(args)...);
+// The positions of the Bs... that are true, in order
+template <bool... Bs>
+constexpr position_array<sizeof...(Bs)> true_positions() noexcept {
+	bool const bs[] = {Bs..., false};
+	position_array<sizeof...(Bs)> result{{}, 0};
+	for(std::size_t i = 0; i < sizeof...(Bs); ++i) {
+		if(bs[i]) {
+			result.values[result.size++] = i;
+		}
 	}
-};
+	return result;
+}
 
-template <int First, int Second, int... Rest>
-struct cycle<First, Second, Rest...> {
-	template <typename Function, typename... Args>
-	constexpr static auto transform(Function&& f, Args&&... args) {
-		static_assert(vta::are_unique_ints<detail::modulus<First, count(args...)>::value,
-		                                   detail::modulus<Second, count(args...)>::value,
-		                                   detail::modulus<Rest, count(args...)>::value...>::value,
-		  "The positions to permute must be unique");
-		return compose<swap<First, Second>, cycle<First, Rest...>>::transform(std::forward<Function>(f), std::forward<Args>(args)...);
+// The positions of Keys... in ascending order of key, where equal keys keep their order
+template <std::intmax_t... Keys>
+constexpr position_array<sizeof...(Keys)> ascending_positions() noexcept {
+	std::intmax_t const keys[] = {Keys..., 0};
+	position_array<sizeof...(Keys)> result{{}, sizeof...(Keys)};
+	for(std::size_t i = 0; i < sizeof...(Keys); ++i) {
+		std::size_t j = i;
+		while(j > 0 && keys[result.values[j - 1]] > keys[i]) {
+			result.values[j] = result.values[j - 1];
+			--j;
+		}
+		result.values[j] = i;
 	}
-};
+	return result;
+}
 
-namespace detail {
+}
 
-template <unsigned N>
-struct reverse_helper {
-	template <typename Function>
-	constexpr static auto transform(Function&&) {
-	}
-
-	template <typename Function, typename Arg>
-	constexpr static auto transform(Function&& f, Arg&& arg) {
-		return id::transform(std::forward<Function>(f), std::forward<Arg>(arg));
-	}
-
-	template <typename Function, typename First, typename... Args>
-	constexpr static auto transform(Function&& f, First&& first, Args&&... args) {
-		return compose<swap<N - 1, -N>,
-		               reverse_helper<N - 1>
-		              >::transform(std::forward<Function>(f),
-		                           std::forward<First>(first),
-		                           std::forward<Args>(args)...);
-	}
-};
-
-template <>
-struct reverse_helper<0u> {
-	template <typename Function, typename... Args>
-	constexpr static auto transform(Function&& f, Args&&... args) {
-		return id::transform(std::forward<Function>(f), std::forward<Args>(args)...);
-	}
-};
-
-}
-
-/** Reverse the order of arguments */
-struct reverse {
-template <typename Function, typename... Args>
-	constexpr static auto transform(Function&& f, Args&&... args) {
-		return detail::reverse_helper<sizeof...(args) / 2>::transform(std::forward<Function>(f),
-		                                                              std::forward<Args>(args)...);
-	}
-};
-
-namespace detail {
-
-template <template <class> class Predicate, typename... Passed>
-struct filter_helper;
-
-template <template <class> class Predicate, bool BPassed, typename... Passed>
-struct next_has_passed;
-
-template <template <class> class Predicate, typename... Passed>
-struct next_has_passed<Predicate, true, Passed...> {
-	template <typename Function, typename Next, typename... ToBeEvaluated>
-	constexpr static auto transform(Function&& f, Passed&&... passed, Next&& next, ToBeEvaluated&&... rest) {
-		return filter_helper<Predicate, Passed..., Next>::transform(std::forward<Function>(f),
-		                                                            std::forward<Passed>(passed)...,
-		                                                            std::forward<Next>(next),
-		                                                            std::forward<ToBeEvaluated>(rest)...);
-	}
-
-	template <typename Function>
-	constexpr static auto transform(Function&& f, Passed&&... passed) {
-		return std::forward<Function>(f)(std::forward<Passed>(passed)...);
-	}
+/** Filter in parameters only if Predicate<Arg>::value is true for each argument type. */
+template <template <class> class Predicate>
+struct filter : detail::positional<filter<Predicate>> {
+	template <typename... Args>
+	struct positions {
+		constexpr static detail::position_array<sizeof...(Args)> kept
+		  = detail::true_positions<static_cast<bool>(Predicate<Args>::value)...>();
+		static std::size_t const size = kept.size;
+
+		// The position of the i-th argument that passed
+		constexpr static std::size_t at(std::size_t i) noexcept {
+			return kept.values[i];
+		}
+	};
 };
 
-template <template <class> class Predicate, typename... Passed>
-struct next_has_passed<Predicate, false, Passed...> {
-	template <typename Function, typename Next, typename... ToBeEvaluated>
-	constexpr static auto transform(Function&& f, Passed&&... passed, Next&&, ToBeEvaluated&&... rest) {
-		return filter_helper<Predicate, Passed...>::transform(std::forward<Function>(f),
-		                                                      std::forward<Passed>(passed)...,
-		                                                      std::forward<ToBeEvaluated>(rest)...);
-	}
-
-	template <typename Function>
-	constexpr static auto transform(Function&& f, Passed&&... passed) {
-		return std::forward<Function>(f)(std::forward<Passed>(passed)...);
-	}
-};
+template <template <class> class Predicate>
+template <typename... Args>
+constexpr detail::position_array<sizeof...(Args)> filter<Predicate>::positions<Args...>::kept;
 
-template <template <class> class Predicate, typename... Passed>
-struct filter_helper {
-	template <typename Function, typename Next, typename... ToBeEvaluated>
-	constexpr static auto transform(Function&& f, Passed&&... passed, Next&& next, ToBeEvaluated&&... rest) {
-		typedef next_has_passed<Predicate,
-		                        Predicate<Next>::value,
-		                        Passed...> NextTransform;
-		return NextTransform::transform(std::forward<Function>(f),
-		                                std::forward<Passed>(passed)...,
-		                                std::forward<Next>(next),
-		                                std::forward<ToBeEvaluated>(rest)...);
-	}
+/** Forwards the arguments in ascending order of KeyTrait<Arg>::value, which must be an integral
+    constant, keeping arguments with equal keys in the order they were passed. */
+template <template <class> class KeyTrait>
+struct sort_by : detail::positional<sort_by<KeyTrait>> {
+	template <typename... Args>
+	struct positions {
+		constexpr static detail::position_array<sizeof...(Args)> order
+		  = detail::ascending_positions<static_cast<std::intmax_t>(KeyTrait<Args>::value)...>();
+		static std::size_t const size = sizeof...(Args);
 
-	template <typename Function, typename... ToBeEvaluated>
-	constexpr static auto transform(Function&& f, Passed&&... passed) {
-		return std::forward<Function>(f)(std::forward<Passed>(passed)...);
-	}
+		constexpr static std::size_t at(std::size_t i) noexcept {
+			return order.values[i];
+		}
+	};
 };
 
-}
-
-/** Filter in parameters only if Predicate<Arg>::value is true for each argument type. */
-template <template <class> class Predicate>
-struct filter {
-	template <typename Function, typename... Args>
-	constexpr static auto transform(Function&& f, Args&&... args) {
-		typedef detail::filter_helper<Predicate> Next;
-		return Next::transform(std::forward<Function>(f),
-		                       std::forward<Args>(args)...);
-	}
-};
+template <template <class> class KeyTrait>
+template <typename... Args>
+constexpr detail::position_array<sizeof...(Args)> sort_by<KeyTrait>::positions<Args...>::order;
 
 /**************************************************************************************************
  * Functions                                                                                      *
@@ -685,6 +737,17 @@ public:
 	: mF(std::move(f)) {
 	}
 
+#if defined(VTA_DETAIL_FOLD_EXPRESSIONS)
+	template <typename... Args>
+	constexpr void operator()(Args&&... args) const {
+		(static_cast<void>(mF(std::forward<Args>(args))), ...);
+	}
+
+	template <typename... Args>
+	constexpr void operator()(Args&&... args) {
+		(static_cast<void>(mF(std::forward<Args>(args))), ...);
+	}
+#else
 	template <typename First, typename... Args>
 	constexpr void operator()(First&& first, Args&&... args) const {
 		mF(std::forward<First>(first));
@@ -699,6 +762,7 @@ public:
 
 	constexpr void operator()() const {
 	}
+#endif
 };
 
 template <typename Function>
@@ -706,8 +770,39 @@ constexpr map_f<typename std::remove_reference<Function>::type> map(Function&& f
 	return {std::forward<Function>(f)};
 }
 
+namespace detail {
+
+template <std::size_t I, typename Arg>
+constexpr std::remove_reference_t<Arg>& get_lvalue(forward_leaf<I, Arg> const& leaf) noexcept {
+	return leaf.value;
+}
+
+// Calls f on each window of N adjacent arguments of a forward_pack, starting at each of Begins. The
+// first argument of a window is forwarded, as no later window includes it, and the others are
+// passed as lvalues.
+template <std::size_t N>
+struct adjacent_windows {
+	template <std::size_t Begin, typename Function, typename Pack, std::size_t... Is>
+	constexpr static void call(Function& f, Pack const& pack, std::index_sequence<Is...>) {
+		f(get<Begin>(pack), get_lvalue<Begin + 1 + Is>(pack)...);
+	}
+
+	template <typename Function, typename Pack, std::size_t... Begins>
+	constexpr static void transform(Function& f, Pack const& pack, std::index_sequence<Begins...>) {
+		int const expand[] = {0, (call<Begins>(f, pack, std::make_index_sequence<N - 1>{}), 0)...};
+		static_cast<void>(expand);
+	}
+};
+
+}
+
 template <unsigned N, typename Function>
 class adjacent_map_f {
+	static_assert(N > 0, "adjacent_map needs windows of at least one argument");
+
+	template <typename... Args>
+	using windows = std::make_index_sequence<(sizeof...(Args) >= N ? sizeof...(Args) - N + 1 : 0)>;
+
 	Function mF;
 
 public:
@@ -715,16 +810,16 @@ public:
 	: mF(std::move(f)) {
 	}
 
-	template <typename First, typename... Args>
-	void operator()(First&& first, Args&&... args) const {
-		take<N>::transform(mF, std::forward<First>(first), args...);
-		call_if<(sizeof...(args) >= N)>::transform(*this, std::forward<Args>(args)...);
+	template <typename... Args>
+	constexpr void operator()(Args&&... args) const {
+		detail::forward_pack<std::index_sequence_for<Args...>, Args...> const pack{std::forward<Args>(args)...};
+		detail::adjacent_windows<N>::transform(mF, pack, windows<Args...>{});
 	}
 
-	template <typename First, typename... Args>
-	void operator()(First&& first, Args&&... args) {
-		take<N>::transform(mF, std::forward<First>(first), args...);
-		call_if<(sizeof...(args) >= N)>::transform(*this, std::forward<Args>(args)...);
+	template <typename... Args>
+	constexpr void operator()(Args&&... args) {
+		detail::forward_pack<std::index_sequence_for<Args...>, Args...> const pack{std::forward<Args>(args)...};
+		detail::adjacent_windows<N>::transform(mF, pack, windows<Args...>{});
 	}
 };
 
@@ -733,6 +828,46 @@ constexpr adjacent_map_f<N, typename std::remove_reference<Function>::type> adja
 	return {std::forward<Function>(f)};
 }
 
+#if defined(VTA_DETAIL_FOLD_EXPRESSIONS)
+
+namespace detail {
+
+// An argument, or the result of calling Function, in a fold expression over |. Arguments are held
+// by reference and results as the exact type that Function returned, so that a prvalue result is
+// constructed in place and then forwarded to the next call as an xvalue.
+template <typename Function, typename T>
+struct fold_operand {
+	Function& f;
+	T value;
+};
+
+template <typename Function, typename T>
+constexpr fold_operand<Function, T&&> make_fold_operand(Function& f, T&& value) noexcept {
+	return {f, std::forward<T>(value)};
+}
+
+template <typename Function, typename L, typename R>
+constexpr fold_operand<Function, decltype(std::declval<Function&>()(std::declval<L>(), std::declval<R>()))>
+operator|(fold_operand<Function, L>&& lhs, fold_operand<Function, R>&& rhs) {
+	return {lhs.f, lhs.f(std::forward<L>(lhs.value), std::forward<R>(rhs.value))};
+}
+
+// The result of a left fold, which is returned by value unless it is an lvalue reference
+template <typename Function, typename T>
+constexpr std::conditional_t<std::is_lvalue_reference<T>::value, T, std::remove_reference_t<T>>
+left_fold_result(fold_operand<Function, T>&& operand) {
+	return std::forward<T>(operand.value);
+}
+
+template <typename Function, typename T>
+constexpr T&& forward_value(fold_operand<Function, T>&& operand) noexcept {
+	return std::forward<T>(operand.value);
+}
+
+} // namespace detail
+
+#endif
+
 template <typename Function>
 class foldl_f {
 	Function mF;
@@ -742,14 +877,29 @@ public:
 	: mF(std::move(f)) {
 	}
 
+#if defined(VTA_DETAIL_FOLD_EXPRESSIONS)
+	template <typename First, typename Second, typename... Args>
+	constexpr decltype(auto) operator()(First&& first, Second&& second, Args&&... args) const {
+		return detail::left_fold_result(((detail::make_fold_operand(mF, std::forward<First>(first))
+		                                  | detail::make_fold_operand(mF, std::forward<Second>(second)))
+		                                 | ... | detail::make_fold_operand(mF, std::forward<Args>(args))));
+	}
+
+	template <typename First, typename Second, typename... Args>
+	constexpr decltype(auto) operator()(First&& first, Second&& second, Args&&... args) {
+		return detail::left_fold_result(((detail::make_fold_operand(mF, std::forward<First>(first))
+		                                  | detail::make_fold_operand(mF, std::forward<Second>(second)))
+		                                 | ... | detail::make_fold_operand(mF, std::forward<Args>(args))));
+	}
+#else
 	template <typename First, typename Second, typename... Args>
-	constexpr auto operator()(First&& first, Second&& second, Args&&... args) const {
+	constexpr decltype(auto) operator()(First&& first, Second&& second, Args&&... args) const {
 		return (*this)(mF(std::forward<First>(first), std::forward<Second>(second)),
 		                  std::forward<Args>(args)...);
 	}
 
 	template <typename First, typename Second, typename... Args>
-	auto operator()(First&& first, Second&& second, Args&&... args) {
+	decltype(auto) operator()(First&& first, Second&& second, Args&&... args) {
 		return (*this)(mF(std::forward<First>(first), std::forward<Second>(second)),
 		                  std::forward<Args>(args)...);
 	}
@@ -759,6 +909,7 @@ private:
 	constexpr Arg operator()(Arg&& arg) const {
 		return std::forward<Arg>(arg);
 	}
+#endif
 };
 
 template <typename Function>
@@ -766,23 +917,167 @@ constexpr foldl_f<typename std::remove_reference<Function>::type> foldl(Function
 	return {std::forward<Function>(f)};
 }
 
+namespace detail {
+
+// The type of folding Args... into an accumulator of type Acc, where each step calls f with the
+// accumulator as an rvalue and the argument as an lvalue, as fanout_step does
+template <typename Function, typename Acc, typename... Args>
+struct fold_accumulator {
+	typedef Acc type;
+};
+
+template <typename Function, typename Acc, typename Arg, typename... Args>
+struct fold_accumulator<Function, Acc, Arg, Args...>
+: fold_accumulator<Function, std::decay_t<decltype(std::declval<Function&>()(std::declval<Acc>(), std::declval<Arg&>()))>,
+                   Args...> {};
+
+// The type that each fold of fanout accumulates into. The first two arguments are passed to f as
+// lvalues, as each argument is passed to every function, and so are the rest along with the
+// accumulator so far as an rvalue.
+template <typename Function, typename First, typename... Args>
+struct fanout_accumulator {
+	typedef std::decay_t<First> type;
+};
+
+template <typename Function, typename First, typename Second, typename... Args>
+struct fanout_accumulator<Function, First, Second, Args...>
+: fold_accumulator<Function, std::decay_t<decltype(std::declval<Function&>()(std::declval<First&>(), std::declval<Second&>()))>,
+                   Args...> {};
+
+template <typename Function, typename... Args>
+using fold_accumulator_t = typename fanout_accumulator<Function, Args...>::type;
+
+template <typename Functions, typename Accumulators, std::size_t... Is, typename Arg>
+constexpr void fanout_step(Functions& fs, Accumulators& accumulators, std::index_sequence<Is...>, Arg& arg) {
+	int const expand[] = {0, (std::get<Is>(accumulators)
+	                            = std::get<Is>(fs)(std::move(std::get<Is>(accumulators)), arg), 0)...};
+	static_cast<void>(expand);
+}
+
+template <typename Functions, std::size_t... Is, typename Arg>
+constexpr auto fanout_fold(Functions&, std::index_sequence<Is...>, Arg&& arg) {
+	typedef std::tuple<fold_accumulator_t<std::tuple_element_t<Is, Functions>, Arg>...> accumulators;
+	return accumulators{(static_cast<void>(Is), arg)...};
+}
+
+// Folds every function in fs over the arguments in a single pass, where each argument is passed to
+// all of the functions before moving on to the next
+template <typename Functions, std::size_t... Is, typename First, typename Second, typename... Args>
+constexpr auto fanout_fold(Functions& fs, std::index_sequence<Is...> folds, First&& first, Second&& second,
+                           Args&&... args) {
+	std::tuple<fold_accumulator_t<std::tuple_element_t<Is, Functions>, First, Second, Args...>...>
+	  accumulators{std::get<Is>(fs)(first, second)...};
+	int const expand[] = {0, (fanout_step(fs, accumulators, folds, args), 0)...};
+	static_cast<void>(expand);
+	static_cast<void>(folds);
+	return accumulators;
+}
+
+}
+
+template <typename... Functions>
+class fanout_f {
+	std::tuple<Functions...> mFs;
+
+public:
+	constexpr fanout_f(Functions... fs)
+	: mFs(std::move(fs)...) {
+	}
+
+	template <typename... Args>
+	constexpr auto operator()(Args&&... args) const {
+		return detail::fanout_fold(mFs, std::index_sequence_for<Functions...>{}, std::forward<Args>(args)...);
+	}
+
+	template <typename... Args>
+	constexpr auto operator()(Args&&... args) {
+		return detail::fanout_fold(mFs, std::index_sequence_for<Functions...>{}, std::forward<Args>(args)...);
+	}
+};
+
+/** Returns a functor that left folds each of fs over its arguments, as foldl does, but in a single
+    pass over them, and returns the results in a std::tuple. */
+template <typename... Functions>
+constexpr fanout_f<typename std::remove_reference<Functions>::type...> fanout(Functions&&... fs) {
+	return {std::forward<Functions>(fs)...};
+}
+
+template <typename Accumulator, typename Function>
+class foldl_into_f {
+	Accumulator& mAcc;
+	Function mF;
+
+public:
+	constexpr foldl_into_f(Accumulator& acc, Function f)
+	: mAcc(acc)
+	, mF(std::move(f)) {
+	}
+
+	template <typename... Args>
+	constexpr Accumulator& operator()(Args&&... args) const {
+		int const expand[] = {0, (static_cast<void>(mF(mAcc, std::forward<Args>(args))), 0)...};
+		static_cast<void>(expand);
+		return mAcc;
+	}
+
+	template <typename... Args>
+	constexpr Accumulator& operator()(Args&&... args) {
+		int const expand[] = {0, (static_cast<void>(mF(mAcc, std::forward<Args>(args))), 0)...};
+		static_cast<void>(expand);
+		return mAcc;
+	}
+};
+
+/** Returns a functor that calls f(acc, arg) for each of its arguments in turn, where f updates acc
+    in place through an lvalue reference instead of returning a new accumulator, and then returns
+    acc. acc must outlive the returned functor. */
+template <typename Accumulator, typename Function>
+constexpr foldl_into_f<Accumulator, typename std::remove_reference<Function>::type>
+foldl_into(Accumulator& acc, Function&& f) {
+	return {acc, std::forward<Function>(f)};
+}
+
+template <typename Accumulator, typename Function>
+void foldl_into(Accumulator const&&, Function&&) = delete;
+
 template <typename Function>
 class foldr_f {
 	Function mF;
 
 public:
-	foldr_f(Function f)
+	constexpr foldr_f(Function f)
 	: mF(std::move(f)) {
 	}
 
+#if defined(VTA_DETAIL_FOLD_EXPRESSIONS)
+	template <typename First, typename... Args>
+	constexpr decltype(auto) operator()(First&& first, Args&&... args) const {
+		if constexpr(sizeof...(Args) == 0) {
+			return static_cast<First>(std::forward<First>(first));
+		} else {
+			return mF(std::forward<First>(first),
+			          detail::forward_value((detail::make_fold_operand(mF, std::forward<Args>(args)) | ...)));
+		}
+	}
+
+	template <typename First, typename... Args>
+	constexpr decltype(auto) operator()(First&& first, Args&&... args) {
+		if constexpr(sizeof...(Args) == 0) {
+			return static_cast<First>(std::forward<First>(first));
+		} else {
+			return mF(std::forward<First>(first),
+			          detail::forward_value((detail::make_fold_operand(mF, std::forward<Args>(args)) | ...)));
+		}
+	}
+#else
 	template <typename First, typename Second, typename... Args>
-	constexpr auto operator()(First&& first, Second&& second, Args&&... args) const {
+	constexpr decltype(auto) operator()(First&& first, Second&& second, Args&&... args) const {
 		return mF(std::forward<First>(first),
 		          (*this)(std::forward<Second>(second), std::forward<Args>(args)...));
 	}
 
 	template <typename First, typename Second, typename... Args>
-	auto operator()(First&& first, Second&& second, Args&&... args) {
+	decltype(auto) operator()(First&& first, Second&& second, Args&&... args) {
 		return mF(std::forward<First>(first),
 		          (*this)(std::forward<Second>(second), std::forward<Args>(args)...));
 	}
@@ -791,6 +1086,7 @@ public:
 	constexpr Arg operator()(Arg&& arg) const noexcept {
 		return std::forward<Arg>(arg);
 	}
+#endif
 };
 
 template <typename Function>
@@ -798,6 +1094,64 @@ constexpr foldr_f<typename std::remove_reference<Function>::type> foldr(Function
 	return {std::forward<Function>(f)};
 }
 
+namespace detail {
+
+// Folds the arguments of a forward_pack in [Begin, End) by splitting the range in half, so that
+// both halves are independent of each other and the nesting depth is logarithmic in its size.
+template <std::size_t Begin, std::size_t End, bool = (End - Begin == 1)>
+struct tree_fold {
+	template <typename Function, typename Pack>
+	constexpr static decltype(auto) transform(Function& f, Pack const& pack) {
+		constexpr std::size_t middle = Begin + (End - Begin) / 2;
+		return f(tree_fold<Begin, middle>::transform(f, pack),
+		         tree_fold<middle, End>::transform(f, pack));
+	}
+};
+
+template <std::size_t Begin, std::size_t End>
+struct tree_fold<Begin, End, true> {
+	template <typename Function, typename Pack>
+	constexpr static decltype(auto) transform(Function&, Pack const& pack) noexcept {
+		return get<Begin>(pack);
+	}
+};
+
+} // namespace detail
+
+template <typename Function>
+class fold_tree_f {
+	Function mF;
+
+public:
+	constexpr fold_tree_f(Function f)
+	: mF(std::move(f)) {
+	}
+
+	template <typename First, typename Second, typename... Args>
+	constexpr decltype(auto) operator()(First&& first, Second&& second, Args&&... args) const {
+		detail::forward_pack<std::make_index_sequence<sizeof...(Args) + 2>, First, Second, Args...> const pack{
+		    std::forward<First>(first), std::forward<Second>(second), std::forward<Args>(args)...};
+		return detail::tree_fold<0, sizeof...(Args) + 2>::transform(mF, pack);
+	}
+
+	template <typename First, typename Second, typename... Args>
+	decltype(auto) operator()(First&& first, Second&& second, Args&&... args) {
+		detail::forward_pack<std::make_index_sequence<sizeof...(Args) + 2>, First, Second, Args...> const pack{
+		    std::forward<First>(first), std::forward<Second>(second), std::forward<Args>(args)...};
+		return detail::tree_fold<0, sizeof...(Args) + 2>::transform(mF, pack);
+	}
+
+	template <typename Arg>
+	constexpr Arg operator()(Arg&& arg) const noexcept {
+		return std::forward<Arg>(arg);
+	}
+};
+
+template <typename Function>
+constexpr fold_tree_f<typename std::remove_reference<Function>::type> fold_tree(Function&& f) {
+	return {std::forward<Function>(f)};
+}
+
 template <typename Function>
 class all_of_f {
 	Function mF;
@@ -807,6 +1161,17 @@ public:
 	: mF(std::move(f)) {
 	}
 
+#if defined(VTA_DETAIL_FOLD_EXPRESSIONS)
+	template <typename... Args>
+	constexpr bool operator()(Args&&... args) const {
+		return (static_cast<bool>(mF(std::forward<Args>(args))) && ...);
+	}
+
+	template <typename... Args>
+	constexpr bool operator()(Args&&... args) {
+		return (static_cast<bool>(mF(std::forward<Args>(args))) && ...);
+	}
+#else
 	template <typename First, typename... Args>
 	constexpr bool operator()(First&& first, Args&&... args) const {
 		return mF(std::forward<First>(first)) ? operator()(std::forward<Args>(args)...) : false;
@@ -820,6 +1185,7 @@ public:
 	constexpr bool operator()() const {
 		return true;
 	}
+#endif
 };
 
 template <typename Function>
@@ -836,6 +1202,17 @@ public:
 	: mF(std::move(f)) {
 	}
 
+#if defined(VTA_DETAIL_FOLD_EXPRESSIONS)
+	template <typename... Args>
+	constexpr bool operator()(Args&&... args) const {
+		return (static_cast<bool>(mF(std::forward<Args>(args))) || ...);
+	}
+
+	template <typename... Args>
+	constexpr bool operator()(Args&&... args) {
+		return (static_cast<bool>(mF(std::forward<Args>(args))) || ...);
+	}
+#else
 	template <typename First, typename... Args>
 	constexpr bool operator()(First&& first, Args&&... args) const {
 		return mF(std::forward<First>(first)) ? true : operator()(std::forward<Args>(args)...);
@@ -849,6 +1226,7 @@ public:
 	constexpr bool operator()() const {
 		return false;
 	}
+#endif
 };
 
 template <typename Function>
@@ -865,6 +1243,17 @@ public:
 	: mF(std::move(f)) {
 	}
 
+#if defined(VTA_DETAIL_FOLD_EXPRESSIONS)
+	template <typename... Args>
+	constexpr bool operator()(Args&&... args) const {
+		return !(static_cast<bool>(mF(std::forward<Args>(args))) || ...);
+	}
+
+	template <typename... Args>
+	constexpr bool operator()(Args&&... args) {
+		return !(static_cast<bool>(mF(std::forward<Args>(args))) || ...);
+	}
+#else
 	template <typename First, typename... Args>
 	constexpr bool operator()(First&& first, Args&&... args) const {
 		return mF(std::forward<First>(first)) ? false : operator()(std::forward<Args>(args)...);
@@ -878,6 +1267,7 @@ public:
 	constexpr bool operator()() const noexcept {
 		return true;
 	}
+#endif
 };
 
 template <typename Function>
@@ -894,48 +1284,639 @@ constexpr T const& add_const(T&& t) noexcept {
 	return t;
 }
 
+template <typename Function>
+class by_ref_f {
+	Function& mF;
+
+public:
+	constexpr by_ref_f(Function& f) noexcept
+	: mF(f) {
+	}
+
+	template <typename... Args>
+	constexpr decltype(auto) operator()(Args&&... args) const {
+		return mF(std::forward<Args>(args)...);
+	}
+};
+
+/** Refers to f instead of copying it, so that map(by_ref(f)) and the like call f itself. f must
+    outlive the returned functor. */
+template <typename Function>
+constexpr by_ref_f<Function> by_ref(Function& f) noexcept {
+	return {f};
+}
+
+template <typename Function>
+void by_ref(Function const&&) = delete;
+
+// Returns a reference to an lvalue argument but moves an rvalue into the result, so that binding the
+// result of head(make_string()) to a const reference extends the lifetime of a value as before
 template <typename Arg, typename... Args>
-constexpr auto head(Arg&& head, Args&&...) noexcept {
+constexpr Arg head(Arg&& head, Args&&...) noexcept {
 	return std::forward<Arg>(head);
 }
 
-template <typename Arg>
-constexpr auto last(Arg&& arg) noexcept {
-	return std::forward<Arg>(arg);
+namespace detail {
+
+// Accepts and discards an argument of any type without copying it. Having a parameter of type
+// ignore<I> for every I < N in a function's signature lets it skip the first N arguments in a
+// single call instead of peeling them off one at a time.
+template <std::size_t I>
+struct ignore {
+	template <typename T>
+	constexpr ignore(T&&) noexcept {
+	}
+};
+
+template <typename Indices>
+struct at_helper;
+
+template <std::size_t... Is>
+struct at_helper<std::index_sequence<Is...>> {
+	template <typename Arg, typename... Args>
+	constexpr static Arg get(ignore<Is>..., Arg&& arg, Args&&...) noexcept {
+		return std::forward<Arg>(arg);
+	}
+
+	template <typename Arg>
+	static type_tag<Arg> select(ignore<Is>..., type_tag<Arg>*, ...);
+};
+
+template <int N, typename... Args>
+struct type_at {
+	typedef typename decltype(at_helper<std::make_index_sequence<pack_index<N, sizeof...(Args)>::value>>
+	                            ::select(static_cast<type_tag<Args>*>(nullptr)...))::type type;
+};
+
+}
+
+template <int N, typename... Args>
+constexpr decltype(auto) at(Args&&... args) noexcept {
+	typedef std::make_index_sequence<detail::pack_index<N, sizeof...(Args)>::value> Skipped;
+	return detail::at_helper<Skipped>::get(std::forward<Args>(args)...);
 }
 
-template <typename Arg1, typename... Args>
-constexpr auto last(Arg1&&, Args&&... rest) noexcept {
-	return last(std::forward<Args>(rest)...);
+template <typename... Args>
+constexpr decltype(auto) last(Args&&... args) noexcept {
+	return at<-1>(std::forward<Args>(args)...);
 }
 
 namespace detail {
 
-template <unsigned N>
-struct at_helper;
+// A table with an entry for each argument that calls a Function with that argument, so that an
+// argument chosen at runtime can be visited with one indirect call.
+template <typename Indices, typename Function, typename... Args>
+struct visit_table;
 
-template <unsigned N>
-struct at_helper {
-	template <typename Arg, typename... Args>
-	constexpr static auto get(Arg&&, Args&&... args) noexcept {
-		return at_helper<N - 1>::get(std::forward<Args>(args)...);
+template <std::size_t... Is, typename Function, typename... Args>
+struct visit_table<std::index_sequence<Is...>, Function, Args...> {
+	typedef forward_pack<std::index_sequence<Is...>, Args...> pack;
+	typedef decltype(std::declval<Function>()(std::declval<typename type_at<0, Args...>::type>())) result;
+	static_assert(are_same<result, decltype(std::declval<Function>()(std::declval<Args>()))...>::value,
+	  "f must return the same type for every argument");
+
+	template <std::size_t I>
+	static result call(Function& f, pack const& p) {
+		return std::forward<Function>(f)(get<I>(p));
+	}
+
+	static result visit(std::size_t i, Function& f, pack const& p) {
+		constexpr static result (*const table[])(Function&, pack const&) = {&call<Is>...};
+		return table[i](f, p);
 	}
 };
 
-template <>
-struct at_helper<0u> {
+template <typename T>
+auto member_address_operator(int) -> decltype(std::declval<T&>().operator&(), std::true_type{});
+
+template <typename T>
+std::false_type member_address_operator(...);
+
+template <typename T>
+auto free_address_operator(int) -> decltype(operator&(std::declval<T&>()), std::true_type{});
+
+template <typename T>
+std::false_type free_address_operator(...);
+
+// Whether T overloads the unary operator&
+template <typename T>
+struct has_address_operator
+  : std::integral_constant<bool, decltype(member_address_operator<T>(0))::value
+                                   || decltype(free_address_operator<T>(0))::value> {};
+
+// The address of x as std::addressof finds it, without <memory>. Types that do not overload
+// operator& use the built-in one so that this stays usable in constant expressions before C++17,
+// where std::addressof is not constexpr.
+template <typename T>
+constexpr T* address_of(T& x, std::false_type) noexcept {
+	return &x;
+}
+
+template <typename T>
+T* address_of(T& x, std::true_type) noexcept {
+	return reinterpret_cast<T*>(&const_cast<char&>(reinterpret_cast<char const volatile&>(x)));
+}
+
+template <typename T>
+constexpr T* address_of(T& x) noexcept {
+	return address_of(x, has_address_operator<T>{});
+}
+
+}
+
+template <typename Function, typename... Args>
+decltype(auto) visit_at(std::size_t i, Function&& f, Args&&... args) {
+	static_assert(sizeof...(Args) != 0, "visit_at needs at least one argument to visit");
+	typedef detail::visit_table<std::index_sequence_for<Args...>, Function, Args...> table;
+	if(i >= sizeof...(Args)) {
+		throw std::out_of_range("vta::visit_at: index out of range");
+	}
+	typename table::pack const pack{std::forward<Args>(args)...};
+	return table::visit(i, f, pack);
+}
+
+template <typename First, typename... Args>
+constexpr std::remove_reference_t<First>& runtime_at(std::size_t i, First&& first, Args&&... args) {
+	typedef std::remove_reference_t<First> type;
+	static_assert(are_same<type, std::remove_reference_t<Args>...>::value,
+	  "runtime_at needs arguments of the same type, use visit_at instead");
+	if(i > sizeof...(Args)) {
+		throw std::out_of_range("vta::runtime_at: index out of range");
+	}
+	type* const pointers[] = {detail::address_of(first), detail::address_of(args)...};
+	return *pointers[i];
+}
+
+namespace detail {
+
+// The number of bits in a std::size_t, counted without <climits>
+constexpr std::size_t size_bits() noexcept {
+	std::size_t bits = 0;
+	for(std::size_t x = ~std::size_t{0}; x != 0; x >>= 1) {
+		++bits;
+	}
+	return bits;
+}
+
+// Calls f with std::integral_constant<bool, B>{} for each of N flags, where the first flag is the
+// most significant bit of Mask. The masks of the whole table are only template arguments of
+// dispatch, as in the names of the 2^N entries they would make every symbol as long as the table.
+template <typename Function, std::size_t N>
+struct bool_dispatch {
+	template <std::size_t Mask, std::size_t... Js>
+	static decltype(auto) call_flags(Function& f, std::index_sequence<Js...>) {
+		return std::forward<Function>(f)(
+		  std::integral_constant<bool, ((Mask >> (N - 1 - Js)) & 1) != 0>{}...);
+	}
+
+	template <std::size_t Mask>
+	static decltype(auto) call(Function& f) {
+		return call_flags<Mask>(f, std::make_index_sequence<N>{});
+	}
+
+	typedef decltype(call<0>(std::declval<Function&>())) result;
+
+	template <std::size_t... Masks>
+	static result dispatch(std::size_t mask, Function& f, std::index_sequence<Masks...>) {
+		static_assert(are_same<result, decltype(call<Masks>(f))...>::value,
+		  "f must return the same type for every combination of flags");
+		constexpr static result (*const table[])(Function&) = {&call<Masks>...};
+		return table[mask](f);
+	}
+};
+
+}
+
+/** Calls f with std::integral_constant<bool, B>{} in place of each of the runtime flags, through
+    a table with an entry for every combination of them. */
+template <typename Function, typename... Bools>
+decltype(auto) dispatch_bools(Function&& f, Bools... bools) {
+	static_assert(sizeof...(Bools) < detail::size_bits(), "Too many flags to dispatch on");
+	bool const flags[] = {false, static_cast<bool>(bools)...};
+	std::size_t mask = 0;
+	for(bool flag : flags) {
+		mask = mask * 2 + flag;
+	}
+	return detail::bool_dispatch<Function, sizeof...(Bools)>::dispatch(
+	  mask, f, std::make_index_sequence<std::size_t{1} << sizeof...(Bools)>{});
+}
+
+namespace detail {
+
+// Calls f with std::integral_constant<int, I>{} for each of the indices that the row-major position
+// Flat stands for in a table of dimensions Ns...
+template <typename Function, int... Ns>
+struct index_dispatch {
+	typedef Function function;
+
+	constexpr static std::size_t dimension(std::size_t k) noexcept {
+		int const ns[] = {Ns..., 0};
+		return static_cast<std::size_t>(ns[k]);
+	}
+
+	constexpr static std::size_t stride(std::size_t k) noexcept {
+		std::size_t result = 1;
+		for(std::size_t j = k + 1; j < sizeof...(Ns); ++j) {
+			result *= dimension(j);
+		}
+		return result;
+	}
+
+	constexpr static std::size_t size() noexcept {
+		return sizeof...(Ns) == 0 ? 1 : stride(0) * dimension(0);
+	}
+
+	template <std::size_t Flat, std::size_t... Ks>
+	constexpr static decltype(auto) call_indices(Function& f, std::index_sequence<Ks...>) {
+		return std::forward<Function>(f)(
+		  std::integral_constant<int, static_cast<int>(Flat / stride(Ks) % dimension(Ks))>{}...);
+	}
+
+	template <std::size_t Flat>
+	constexpr static decltype(auto) call(Function& f) {
+		return call_indices<Flat>(f, std::make_index_sequence<sizeof...(Ns)>{});
+	}
+
+	typedef decltype(call<0>(std::declval<Function&>())) result;
+
+	// Each index is checked in a type wide enough for any integer before it is narrowed, so a large
+	// std::size_t cannot wrap around into the range
+	template <typename... Indices>
+	constexpr static std::size_t flatten(Indices... indices) {
+		std::uintmax_t const is[] = {unsigned_index(indices, std::is_signed<Indices>{})..., 0};
+		std::size_t flat = 0;
+		for(std::size_t k = 0; k < sizeof...(Ns); ++k) {
+			if(is[k] >= dimension(k)) {
+				throw std::out_of_range("vta::with_indices: index out of range");
+			}
+			flat += static_cast<std::size_t>(is[k]) * stride(k);
+		}
+		return flat;
+	}
+
+	// A negative index becomes the largest value so that it fails the same check as one too large
+	template <typename Index>
+	constexpr static std::uintmax_t unsigned_index(Index i, std::true_type) noexcept {
+		return i < 0 ? UINTMAX_MAX : static_cast<std::uintmax_t>(i);
+	}
+
+	template <typename Index>
+	constexpr static std::uintmax_t unsigned_index(Index i, std::false_type) noexcept {
+		return static_cast<std::uintmax_t>(i);
+	}
+};
+
+// The entries of an index_dispatch, as a static member so that it can be used in constant
+// expressions. Only the table itself is named after all of Flats..., not each entry.
+template <typename Dispatch, typename Flats>
+struct index_table;
+
+template <typename Dispatch, std::size_t... Flats>
+struct index_table<Dispatch, std::index_sequence<Flats...>> {
+	typedef typename Dispatch::function function;
+	typedef typename Dispatch::result (*entry)(function&);
+	static_assert(are_same<typename Dispatch::result,
+	                       decltype(Dispatch::template call<Flats>(std::declval<function&>()))...>::value,
+	  "f must return the same type for every index");
+
+	constexpr static entry entries[] = {&Dispatch::template call<Flats>...};
+};
+
+template <typename Dispatch, std::size_t... Flats>
+constexpr typename index_table<Dispatch, std::index_sequence<Flats...>>::entry
+  index_table<Dispatch, std::index_sequence<Flats...>>::entries[];
+
+// Moves f from the end of the arguments of with_indices to the front
+template <int... Ns>
+struct with_indices_f {
+	template <typename Function, typename... Indices>
+	constexpr decltype(auto) operator()(Function&& f, Indices... indices) const {
+		typedef index_dispatch<Function, Ns...> dispatch;
+		typedef index_table<dispatch, std::make_index_sequence<dispatch::size()>> table;
+		return table::entries[dispatch::flatten(indices...)](f);
+	}
+};
+
+}
+
+/** Calls f with std::integral_constant<int, I>{} for each of the runtime indices I, which must be
+    in [0, N) for the corresponding dimension N of Ns..., through a single table with an entry for
+    every combination of indices. The function comes after the indices. */
+template <int... Ns, typename... Args>
+constexpr decltype(auto) with_indices(Args&&... args) {
+	static_assert(sizeof...(Args) == sizeof...(Ns) + 1,
+	  "with_indices needs an index for each dimension followed by f");
+	static_assert(detail::all_true<(Ns > 0)...>::value,
+	  "with_indices needs dimensions of at least one index");
+	return right_shift<(sizeof...(Ns) > 0 ? 1 : 0)>::transform(detail::with_indices_f<Ns...>{},
+	                                                         std::forward<Args>(args)...);
+}
+
+/** Calls f with std::integral_constant<int, i>{}, where i must be in [0, N). */
+template <int N, typename Index, typename Function>
+constexpr decltype(auto) with_index(Index i, Function&& f) {
+	return with_indices<N>(i, std::forward<Function>(f));
+}
+
+namespace detail {
+
+struct comparator {
+	std::size_t first;
+	std::size_t second;
+};
+
+template <std::size_t N>
+struct comparator_array {
+	comparator values[N + 1];
+	std::size_t size;
+};
+
+// Writes the comparators of Batcher's odd-even merge sort of n values to out, unless it is null, and
+// returns how many there are. For n <= 8 no sorting network has fewer comparators.
+constexpr std::size_t odd_even_merge_sort(std::size_t n, comparator* out) noexcept {
+	std::size_t size = 0;
+	for(std::size_t p = 1; p < n; p *= 2) {
+		for(std::size_t k = p; k >= 1; k /= 2) {
+			for(std::size_t j = k % p; j + k < n; j += 2 * k) {
+				for(std::size_t i = 0; i < k && i + j + k < n; ++i) {
+					if((i + j) / (2 * p) == (i + j + k) / (2 * p)) {
+						if(out != nullptr) {
+							out[size] = comparator{i + j, i + j + k};
+						}
+						++size;
+					}
+				}
+			}
+		}
+	}
+	return size;
+}
+
+// Writes the comparators of a network that sorts N values to out, unless it is null, and returns
+// how many there are. If Output < N, only the comparators that the value at Output depends on are
+// kept, which leaves a network that selects the Output-th smallest value.
+template <std::size_t N, std::size_t Output>
+constexpr std::size_t selection_network(comparator* out) noexcept {
+	constexpr std::size_t size = odd_even_merge_sort(N, nullptr);
+	comparator all[size + 1] = {};
+	odd_even_merge_sort(N, all);
+
+	bool needed[N + 1] = {};
+	for(std::size_t i = 0; i < N; ++i) {
+		needed[i] = Output >= N || i == Output;
+	}
+
+	// Walk backwards from the outputs, keeping each comparator that touches a value still needed
+	bool kept[size + 1] = {};
+	std::size_t count = 0;
+	for(std::size_t c = size; c-- > 0;) {
+		if(needed[all[c].first] || needed[all[c].second]) {
+			needed[all[c].first] = needed[all[c].second] = true;
+			kept[c] = true;
+			++count;
+		}
+	}
+
+	if(out != nullptr) {
+		std::size_t next = 0;
+		for(std::size_t c = 0; c < size; ++c) {
+			if(kept[c]) {
+				out[next++] = all[c];
+			}
+		}
+	}
+	return count;
+}
+
+template <std::size_t N, std::size_t Output>
+constexpr comparator_array<selection_network<N, Output>(nullptr)> make_sorting_network() noexcept {
+	comparator_array<selection_network<N, Output>(nullptr)> network = {};
+	network.size = selection_network<N, Output>(network.values);
+	return network;
+}
+
+// The comparators that sort N values, or that select the Output-th smallest if Output < N
+template <std::size_t N, std::size_t Output = N>
+struct sorting_network {
+	constexpr static comparator_array<selection_network<N, Output>(nullptr)> comparators
+	  = make_sorting_network<N, Output>();
+};
+
+template <std::size_t N, std::size_t Output>
+constexpr comparator_array<selection_network<N, Output>(nullptr)> sorting_network<N, Output>::comparators;
+
+// Whether a and b cannot be ordered, which is only possible for floating point values
+template <typename T>
+constexpr bool is_unordered(T const& a, T const& b, std::true_type) noexcept {
+	return std::isunordered(a, b);
+}
+
+template <typename T>
+constexpr bool is_unordered(T const&, T const&, std::false_type) noexcept {
+	return false;
+}
+
+// Arithmetic types and pointers are exchanged with a min and a max, which compile to conditional
+// moves or to the min and max instructions instead of a branch. They are written as std::min and
+// std::max are, but when a or b is a NaN both of those give a, so b is then left where it is rather
+// than one of the values being lost.
+template <typename T>
+constexpr void compare_exchange(T& a, T& b, std::true_type) noexcept {
+	T const low = b < a ? b : a;
+	T const high = a < b ? b : a;
+	bool const unordered = is_unordered(a, b, std::is_floating_point<T>{});
+	a = low;
+	b = unordered ? b : high;
+}
+
+template <typename T>
+void compare_exchange(T& a, T& b, std::false_type) {
+	if(b < a) {
+		using std::swap;
+		swap(a, b);
+	}
+}
+
+template <typename Network, typename T, std::size_t N, std::size_t... Cs>
+constexpr void apply_network(std::array<T, N>& values, std::index_sequence<Cs...>) {
+	int const expand[] = {0, (compare_exchange(std::get<Network::comparators.values[Cs].first>(values),
+	                                           std::get<Network::comparators.values[Cs].second>(values),
+	                                           std::is_scalar<T>{}), 0)...};
+	static_cast<void>(expand);
+}
+
+// The arguments in an array, each element constructed in place from its argument
+template <typename First, typename... Args>
+constexpr std::array<std::decay_t<First>, sizeof...(Args) + 1> make_array(First&& first, Args&&... args) {
+	static_assert(are_same_after<std::decay, First, Args...>::value,
+	  "The arguments must all have the same type once references and cv-qualifiers are removed");
+	return {{std::forward<First>(first), std::forward<Args>(args)...}};
+}
+
+template <std::size_t Output, typename T, std::size_t N>
+constexpr void sort_values(std::array<T, N>& values) {
+	typedef sorting_network<N, Output> network;
+	apply_network<network>(values, std::make_index_sequence<network::comparators.size>{});
+}
+
+}
+
+/** Returns an array of the arguments, which must all have the same type once references and
+    cv-qualifiers are removed, sorted in ascending order with operator< by a sorting network chosen
+    at compile time. */
+template <typename First, typename... Args>
+constexpr std::array<std::decay_t<First>, sizeof...(Args) + 1> sort(First&& first, Args&&... args) {
+	auto values = detail::make_array(std::forward<First>(first), std::forward<Args>(args)...);
+	detail::sort_values<sizeof...(Args) + 1>(values);
+	return values;
+}
+
+/** Returns the K-th smallest of the arguments, counting from 0, using only the comparators of a
+    sorting network that it depends on. */
+template <std::size_t K, typename First, typename... Args>
+constexpr std::decay_t<First> nth(First&& first, Args&&... args) {
+	static_assert(K <= sizeof...(Args), "nth needs K to be less than the number of arguments");
+	auto values = detail::make_array(std::forward<First>(first), std::forward<Args>(args)...);
+	detail::sort_values<K>(values);
+	return std::get<K>(std::move(values));
+}
+
+/** Returns the median of the arguments, or the lower of the two middle values if there is an even
+    number of them. */
+template <typename First, typename... Args>
+constexpr std::decay_t<First> median(First&& first, Args&&... args) {
+	return nth<sizeof...(Args) / 2>(std::forward<First>(first), std::forward<Args>(args)...);
+}
+
+namespace detail {
+
+template <typename T>
+struct minmax_accumulator {
+	T min;
+	T max;
+
+	// Orders a and b with one comparison, then compares the smaller with min and the larger with max.
+	// Ties keep the first minimum and the last maximum, as std::minmax does.
+	constexpr void add(T const& a, T const& b) {
+		bool const swapped = b < a;
+		T const& low = swapped ? b : a;
+		T const& high = swapped ? a : b;
+		if(low < min) {
+			min = low;
+		}
+		if(!(high < max)) {
+			max = high;
+		}
+	}
+};
+
+template <std::size_t Offset, typename T, typename Pack, std::size_t... Pairs>
+constexpr std::pair<T, T> minmax_pairs(minmax_accumulator<T> accumulator, Pack const& pack,
+                                       std::index_sequence<Pairs...>) {
+	int const expand[] = {0, (accumulator.add(get_lvalue<Offset + 2 * Pairs>(pack),
+	                                          get_lvalue<Offset + 2 * Pairs + 1>(pack)), 0)...};
+	static_cast<void>(expand);
+	return {std::move(accumulator.min), std::move(accumulator.max)};
+}
+
+// An odd number of arguments starts from the first and an even number from the first two
+template <typename T, std::size_t N, typename Pack>
+constexpr std::pair<T, T> minmax_of(Pack const& pack, std::true_type) {
+	return minmax_pairs<1>(minmax_accumulator<T>{get_lvalue<0>(pack), get_lvalue<0>(pack)}, pack,
+	                       std::make_index_sequence<N / 2>{});
+}
+
+template <typename T, std::size_t N, typename Pack>
+constexpr std::pair<T, T> minmax_of(Pack const& pack, std::false_type) {
+	T const& a = get_lvalue<0>(pack);
+	T const& b = get_lvalue<1>(pack);
+	return minmax_pairs<2>(b < a ? minmax_accumulator<T>{b, a} : minmax_accumulator<T>{a, b}, pack,
+	                       std::make_index_sequence<N / 2 - 1>{});
+}
+
+}
+
+/** Returns the smallest and the largest of the arguments, which must all have the same type once
+    references and cv-qualifiers are removed, comparing them in pairs so that N arguments take about
+    3N / 2 comparisons instead of 2N. Like std::minmax, the first smallest and last largest are
+    returned. */
+template <typename First, typename... Args>
+constexpr std::pair<std::decay_t<First>, std::decay_t<First>> minmax(First&& first, Args&&... args) {
+	static_assert(are_same_after<std::decay, First, Args...>::value,
+	  "minmax needs arguments of the same type");
+	detail::forward_pack<std::index_sequence_for<First, Args...>, First, Args...> const pack{
+	  std::forward<First>(first), std::forward<Args>(args)...};
+	return detail::minmax_of<std::decay_t<First>, sizeof...(Args) + 1>(
+	  pack, std::integral_constant<bool, sizeof...(Args) % 2 == 0>{});
+}
+
+template <typename Function>
+class sorted_f {
+	Function mF;
+
+	template <typename F, typename T, std::size_t N, std::size_t... Is>
+	constexpr static decltype(auto) call(F& f, std::array<T, N>&& values, std::index_sequence<Is...>) {
+		return f(std::get<Is>(std::move(values))...);
+	}
+
+public:
+	constexpr sorted_f(Function f)
+	: mF(std::move(f)) {
+	}
+
 	template <typename... Args>
-	constexpr static auto get(Args&&... args) noexcept {
-		return head(std::forward<Args>(args)...);
+	constexpr decltype(auto) operator()(Args&&... args) const {
+		return call(mF, vta::sort(std::forward<Args>(args)...), std::index_sequence_for<Args...>{});
+	}
+
+	template <typename... Args>
+	constexpr decltype(auto) operator()(Args&&... args) {
+		return call(mF, vta::sort(std::forward<Args>(args)...), std::index_sequence_for<Args...>{});
 	}
 };
 
+/** Calls f with the arguments sorted as by sort, each passed as an rvalue. */
+template <typename Function>
+constexpr sorted_f<typename std::remove_reference<Function>::type> sorted(Function&& f) {
+	return {std::forward<Function>(f)};
 }
 
-template <int N, typename... Args>
-constexpr auto at(Args&&... args) noexcept {
-	static_assert(-count(args...) <= N && N < count(args...), "N is out of bounds");
-	return detail::at_helper<(N + count(args...)) % count(args...)>::get(std::forward<Args>(args)...);
+/**************************************************************************************************
+ * Tuples                                                                                         *
+ **************************************************************************************************/
+
+namespace detail {
+
+template <typename Tuple>
+using tuple_indices = std::make_index_sequence<std::tuple_size<std::remove_reference_t<Tuple>>::value>;
+
+// Passes each element of tuple to Transformation, as get would return it for a tuple of that value
+// category, so the elements of an rvalue tuple are forwarded as rvalues and reference elements are
+// passed as they are.
+template <typename Transformation, typename Function, typename Tuple, std::size_t... Is>
+constexpr decltype(auto) apply_tuple(Function&& f, Tuple&& tuple, std::index_sequence<Is...>) {
+	using std::get;
+	return Transformation::transform(std::forward<Function>(f), get<Is>(std::forward<Tuple>(tuple))...);
+}
+
+}
+
+/** Calls f with the elements of a tuple-like object, such as std::tuple, std::pair or std::array,
+    after Transformation. */
+template <typename Transformation, typename Function, typename Tuple>
+constexpr decltype(auto) apply_after(Function&& f, Tuple&& tuple) {
+	return detail::apply_tuple<Transformation>(std::forward<Function>(f), std::forward<Tuple>(tuple),
+	                                           detail::tuple_indices<Tuple>{});
+}
+
+template <typename Function, typename Tuple>
+constexpr void map(Function&& f, Tuple&& tuple) {
+	apply_after<id>(add_const(map(by_ref(f))), std::forward<Tuple>(tuple));
+}
+
+template <typename Function, typename Tuple>
+constexpr decltype(auto) foldl(Function&& f, Tuple&& tuple) {
+	return apply_after<id>(add_const(foldl(by_ref(f))), std::forward<Tuple>(tuple));
 }
 
 /**************************************************************************************************
@@ -943,15 +1924,15 @@ constexpr auto at(Args&&... args) noexcept {
  **************************************************************************************************/
 
 template <typename... Args>
-using head_t = decltype(head(std::declval<Args>()...));
+using head_t = typename detail::type_at<0, Args...>::type;
 
 template <typename... Args>
-using last_t = decltype(last(std::declval<Args>()...));
+using last_t = typename detail::type_at<-1, Args...>::type;
 
 template <int N>
 struct at_t {
 	template <typename... Args>
-	using type = decltype(at<N>(std::declval<Args>()...));
+	using type = typename detail::type_at<N, Args...>::type;
 };
 
 }
@@ -0,0 +1,64 @@
+/******************************************************************//**
+ * \file   array.hpp
+ * \author Elliot Goodrich
+ *
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *********************************************************************/
+
+#ifndef INCLUDE_GUARD_3C0F5A8E_91D2_4B6E_A7F4_6E2D8B1C9A53
+#define INCLUDE_GUARD_3C0F5A8E_91D2_4B6E_A7F4_6E2D8B1C9A53
+
+#include "algorithms.hpp"
+
+#include <array>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+namespace vta {
+
+/** Builds an array of the arguments, which must all have the same type once references and
+    cv-qualifiers are removed. Each element is constructed in place from its argument, so rvalues
+    are moved and lvalues copied. */
+template <typename First, typename... Args>
+constexpr std::array<std::decay_t<First>, sizeof...(Args) + 1> to_array(First&& first, Args&&... args) {
+	return detail::make_array(std::forward<First>(first), std::forward<Args>(args)...);
+}
+
+/** Builds an array of references to the arguments, which must all be lvalues of the same type. */
+template <typename First, typename... Args>
+std::array<std::reference_wrapper<std::remove_reference_t<First>>, sizeof...(Args) + 1>
+to_span_of_refs(First&& first, Args&&... args) noexcept {
+	static_assert(detail::all_true<std::is_lvalue_reference<First>::value,
+	                               std::is_lvalue_reference<Args>::value...>::value,
+	  "to_span_of_refs needs lvalues, as it would otherwise refer to temporaries");
+	static_assert(are_same_after<std::remove_reference, First, Args...>::value,
+	  "to_span_of_refs needs arguments of the same type, use to_array to copy them instead");
+	return {{first, args...}};
+}
+
+}
+
+#endif
@@ -0,0 +1,154 @@
+/******************************************************************//**
+ * \file   packed_tuple.hpp
+ * \author Elliot Goodrich
+ *
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *********************************************************************/
+
+#ifndef INCLUDE_GUARD_7BF731B3_6D06_4709_8441_3205E5C28EDE
+#define INCLUDE_GUARD_7BF731B3_6D06_4709_8441_3205E5C28EDE
+
+#include "algorithms.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace vta {
+
+namespace detail {
+
+// Orders types from the most strictly aligned to the least, which leaves no padding between them
+template <typename T>
+struct descending_alignment
+: std::integral_constant<std::intmax_t, -static_cast<std::intmax_t>(alignof(T))> {};
+
+// The element at position I of a packed_tuple, in declaration order
+template <std::size_t I, typename T>
+struct packed_leaf {
+	T value;
+
+	constexpr packed_leaf()
+	: value() {
+	}
+
+	template <typename U>
+	constexpr packed_leaf(U&& u)
+	: value(std::forward<U>(u)) {
+	}
+};
+
+// The declaration positions of Ts... in the order that they are stored
+template <typename... Ts>
+using packed_order = typename generate_positions<
+  typename sort_by<descending_alignment>::template positions<Ts...>>::type;
+
+// Derives from the leaf for each of Ts... in the order of Positions, which is the order they are laid
+// out in memory, while each leaf is still named by its position in Ts...
+template <typename Positions, typename... Ts>
+struct packed_storage;
+
+template <std::size_t... Positions, typename... Ts>
+struct packed_storage<std::index_sequence<Positions...>, Ts...>
+: packed_leaf<Positions, type_at_position<Positions, Ts...>>... {
+	constexpr packed_storage()
+	: packed_leaf<Positions, type_at_position<Positions, Ts...>>()... {
+	}
+
+	// Constructs each element from the argument at its position in a forward_pack
+	template <typename Pack>
+	constexpr explicit packed_storage(Pack const& pack)
+	: packed_leaf<Positions, type_at_position<Positions, Ts...>>(get<Positions>(pack))... {
+	}
+};
+
+template <std::size_t I, typename T>
+constexpr packed_leaf<I, T>& leaf(packed_leaf<I, T>& l) noexcept {
+	return l;
+}
+
+template <std::size_t I, typename T>
+constexpr packed_leaf<I, T> const& leaf(packed_leaf<I, T> const& l) noexcept {
+	return l;
+}
+
+}
+
+/** A tuple that lays out its elements from the most strictly aligned to the least, so that there is
+    no padding between them, while get<I> still refers to the elements in the order of Ts... */
+template <typename... Ts>
+class packed_tuple : public detail::packed_storage<detail::packed_order<Ts...>, Ts...> {
+	typedef detail::packed_storage<detail::packed_order<Ts...>, Ts...> storage;
+
+public:
+	static std::size_t const size = sizeof...(Ts);
+
+	constexpr packed_tuple()
+	: storage() {
+	}
+
+	// Constructs each element from the argument in the same position. A single packed_tuple is never
+	// taken as an element, as std::tuple does, so that it is copied by the copy constructor even when
+	// the element type could be constructed from it.
+	template <typename... Us,
+	          typename = std::enable_if_t<sizeof...(Us) == sizeof...(Ts) && sizeof...(Us) != 0
+	            && !std::is_same<detail::type_list<std::decay_t<Us>...>, detail::type_list<packed_tuple>>::value
+	            && detail::all_true<std::is_constructible<Ts, Us&&>::value...>::value>>
+	constexpr packed_tuple(Us&&... values)
+	: storage(detail::forward_pack<std::index_sequence_for<Us...>, Us...>{std::forward<Us>(values)...}) {
+	}
+};
+
+template <std::size_t I, typename... Ts>
+constexpr detail::type_at_position<I, Ts...>& get(packed_tuple<Ts...>& tuple) noexcept {
+	return detail::leaf<I>(tuple).value;
+}
+
+template <std::size_t I, typename... Ts>
+constexpr detail::type_at_position<I, Ts...> const& get(packed_tuple<Ts...> const& tuple) noexcept {
+	return detail::leaf<I>(tuple).value;
+}
+
+template <std::size_t I, typename... Ts>
+constexpr detail::type_at_position<I, Ts...>&& get(packed_tuple<Ts...>&& tuple) noexcept {
+	return static_cast<detail::type_at_position<I, Ts...>&&>(detail::leaf<I>(tuple).value);
+}
+
+}
+
+namespace std {
+
+template <typename... Ts>
+struct tuple_size<vta::packed_tuple<Ts...>> : integral_constant<size_t, sizeof...(Ts)> {};
+
+template <size_t I, typename... Ts>
+struct tuple_element<I, vta::packed_tuple<Ts...>> {
+	typedef vta::detail::type_at_position<I, Ts...> type;
+};
+
+}
+
+#endif
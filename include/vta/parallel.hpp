@@ -0,0 +1,338 @@
+/******************************************************************//**
+ * \file   parallel.hpp
+ * \author Elliot Goodrich
+ *
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *********************************************************************/
+
+#ifndef INCLUDE_GUARD_56E90D66_7644_406A_A0EA_1479359CCE8C
+#define INCLUDE_GUARD_56E90D66_7644_406A_A0EA_1479359CCE8C
+
+#include "algorithms.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace vta {
+
+/**************************************************************************************************
+ * Executors                                                                                      *
+ **************************************************************************************************/
+
+// A fixed number of worker threads that each own a queue of tasks. Workers run the newest task in
+// their own queue first and, once it is empty, steal the oldest task from the queues of the
+// others. Tasks submitted from one of the workers go to that worker's queue, so that nested work
+// stays on the same thread unless another one is idle.
+//
+// Tasks must not throw. execute either queues the task or throws without queueing it. The
+// destructor runs every task that has already been submitted before joining the workers.
+class thread_pool {
+public:
+	explicit thread_pool(std::size_t threads = std::max(1u, std::thread::hardware_concurrency()))
+	: mPending(0)
+	, mStop(false)
+	, mNext(0) {
+		threads = std::max<std::size_t>(threads, 1);
+		for(std::size_t i = 0; i < threads; ++i) {
+			mQueues.push_back(std::make_unique<worker_queue>());
+		}
+		mThreads.reserve(threads);
+		try {
+			for(std::size_t i = 0; i < threads; ++i) {
+				mThreads.emplace_back([this, i] { work(i); });
+			}
+		} catch(...) {
+			// Destroying a joinable std::thread terminates, so stop the workers already started
+			stop();
+			throw;
+		}
+	}
+
+	thread_pool(thread_pool const&) = delete;
+	thread_pool& operator=(thread_pool const&) = delete;
+
+	~thread_pool() {
+		stop();
+	}
+
+	std::size_t size() const noexcept {
+		return mThreads.size();
+	}
+
+	template <typename Task>
+	void execute(Task&& task) {
+		std::function<void()> function{std::forward<Task>(task)};
+
+		worker const& current = this_worker();
+		std::size_t const index = current.pool == this ? current.index : mNext++ % mQueues.size();
+
+		{
+			// The count only goes up once the task is queued, so a push_back that throws leaves the
+			// pool as it was. The queue is locked before mMutex, in the same order as pop.
+			std::lock_guard<std::mutex> lock{mQueues[index]->mutex};
+			mQueues[index]->tasks.push_back(std::move(function));
+			std::lock_guard<std::mutex> pending_lock{mMutex};
+			++mPending;
+		}
+		mWake.notify_one();
+	}
+
+	// Runs one pending task on the calling thread, if there is one, and returns whether it did.
+	// This lets a thread that is waiting for tasks to finish help with them instead of blocking.
+	bool try_run_one() {
+		worker const& current = this_worker();
+		std::function<void()> task;
+		if(!pop(current.pool == this ? current.index : 0, task)) {
+			return false;
+		}
+		task();
+		return true;
+	}
+
+private:
+	struct worker_queue {
+		std::mutex mutex;
+		std::deque<std::function<void()>> tasks;
+	};
+
+	struct worker {
+		thread_pool const* pool;
+		std::size_t index;
+	};
+
+	static worker& this_worker() noexcept {
+		static thread_local worker current{nullptr, 0};
+		return current;
+	}
+
+	// Runs the remaining tasks and joins every worker that has been started
+	void stop() noexcept {
+		{
+			std::lock_guard<std::mutex> lock{mMutex};
+			mStop = true;
+		}
+		mWake.notify_all();
+		for(auto& thread : mThreads) {
+			thread.join();
+		}
+	}
+
+	void work(std::size_t index) {
+		this_worker() = worker{this, index};
+
+		std::function<void()> task;
+		for(;;) {
+			if(pop(index, task)) {
+				task();
+				continue;
+			}
+
+			std::unique_lock<std::mutex> lock{mMutex};
+			mWake.wait(lock, [this] { return mStop || mPending != 0; });
+			if(mStop && mPending == 0) {
+				return;
+			}
+		}
+	}
+
+	// Takes the newest task from the queue at index, or else the oldest task from any other queue
+	bool pop(std::size_t index, std::function<void()>& task) {
+		for(std::size_t i = 0; i < mQueues.size(); ++i) {
+			worker_queue& queue = *mQueues[(index + i) % mQueues.size()];
+			std::lock_guard<std::mutex> lock{queue.mutex};
+			if(!queue.tasks.empty()) {
+				if(i == 0) {
+					task = std::move(queue.tasks.back());
+					queue.tasks.pop_back();
+				} else {
+					task = std::move(queue.tasks.front());
+					queue.tasks.pop_front();
+				}
+				std::lock_guard<std::mutex> pending_lock{mMutex};
+				--mPending;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	std::vector<std::unique_ptr<worker_queue>> mQueues;
+	std::vector<std::thread> mThreads;
+	std::mutex mMutex;
+	std::condition_variable mWake;
+	std::size_t mPending;
+	bool mStop;
+	std::atomic<std::size_t> mNext;
+};
+
+// The pool used by par_map when no executor is given, with one thread per hardware thread
+inline thread_pool& default_thread_pool() {
+	static thread_pool pool;
+	return pool;
+}
+
+namespace detail {
+
+// Counts down the tasks of a single par_map call and keeps the exception, if any, that each one
+// threw so that they can be rethrown in argument order once all of them have finished
+class task_group {
+public:
+	explicit task_group(std::size_t size)
+	: mRemaining(size)
+	, mErrors(size) {
+	}
+
+	template <typename Task>
+	void run(std::size_t i, Task&& task) noexcept {
+		try {
+			std::forward<Task>(task)();
+		} catch(...) {
+			mErrors[i] = std::current_exception();
+		}
+
+		std::lock_guard<std::mutex> lock{mMutex};
+		if(--mRemaining == 0) {
+			mFinished.notify_all();
+		}
+	}
+
+	bool done() const {
+		std::lock_guard<std::mutex> lock{mMutex};
+		return mRemaining == 0;
+	}
+
+	void wait() const {
+		std::unique_lock<std::mutex> lock{mMutex};
+		mFinished.wait(lock, [this] { return mRemaining == 0; });
+	}
+
+	void rethrow() const {
+		for(auto const& error : mErrors) {
+			if(error) {
+				std::rethrow_exception(error);
+			}
+		}
+	}
+
+private:
+	mutable std::mutex mMutex;
+	mutable std::condition_variable mFinished;
+	std::size_t mRemaining;
+	std::vector<std::exception_ptr> mErrors;
+};
+
+template <typename Executor>
+void wait_for(task_group const& group, Executor&) {
+	group.wait();
+}
+
+// Runs queued tasks while waiting so that a par_map called from inside a task of the same pool
+// cannot deadlock with every worker blocked on its own group
+inline void wait_for(task_group const& group, thread_pool& pool) {
+	while(!group.done() && pool.try_run_one()) {
+	}
+	group.wait();
+}
+
+} // namespace detail
+
+/**************************************************************************************************
+ * Functions                                                                                      *
+ **************************************************************************************************/
+
+template <typename Function, typename Executor>
+class par_map_f {
+	Function mF;
+	Executor* mExecutor;
+
+	// Runs f on arg as the task at position I. An executor that throws from execute has not accepted
+	// the task, so it is run on the calling thread instead and the group still finishes.
+	template <std::size_t I, typename Arg>
+	void submit(detail::task_group& group, Arg&& arg) const {
+		auto* const argument = std::addressof(arg);
+		auto task = [this, &group, argument] {
+			group.run(I, [this, argument] { mF(std::forward<Arg>(*argument)); });
+		};
+
+		try {
+			mExecutor->execute(task);
+		} catch(...) {
+			task();
+		}
+	}
+
+	template <std::size_t... Is, typename First, typename... Args>
+	void run(std::index_sequence<Is...>, First&& first, Args&&... args) const {
+		detail::task_group group{sizeof...(Args) + 1};
+
+		int const expand[] = {0, (submit<Is + 1>(group, std::forward<Args>(args)), 0)...};
+		static_cast<void>(expand);
+
+		// The calling thread runs f on the first argument itself rather than sitting idle
+		group.run(0, [this, &first] { mF(std::forward<First>(first)); });
+
+		detail::wait_for(group, *mExecutor);
+		group.rethrow();
+	}
+
+public:
+	constexpr par_map_f(Function f, Executor& executor)
+	: mF(std::move(f))
+	, mExecutor(&executor) {
+	}
+
+	template <typename First, typename... Args>
+	void operator()(First&& first, Args&&... args) const {
+		run(std::index_sequence_for<Args...>{}, std::forward<First>(first), std::forward<Args>(args)...);
+	}
+
+	void operator()() const {
+	}
+};
+
+template <typename Function, typename Executor>
+par_map_f<typename std::remove_reference<Function>::type, Executor> par_map(Function&& f, Executor& executor) {
+	return {std::forward<Function>(f), executor};
+}
+
+template <typename Function>
+par_map_f<typename std::remove_reference<Function>::type, thread_pool> par_map(Function&& f) {
+	return {std::forward<Function>(f), default_thread_pool()};
+}
+
+}
+
+#endif
@@ -0,0 +1,376 @@
+/******************************************************************//**
+ * \file   reduce.hpp
+ * \author Elliot Goodrich
+ *
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *********************************************************************/
+
+#ifndef INCLUDE_GUARD_145BE470_42EB_46B1_818A_5A3427F6B980
+#define INCLUDE_GUARD_145BE470_42EB_46B1_818A_5A3427F6B980
+
+#include "algorithms.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+// The vectorized kernels use GCC vector extensions with 16 byte SSE2 vectors, which every x86-64
+// CPU has, or 32 byte vectors when compiling for AVX2. Elsewhere, or if VTA_NO_SIMD is defined,
+// reduce always falls back to fold_tree. VTA_HAS_REDUCE_KERNELS is left defined so that code using
+// reduce can tell which of these it gets.
+#if !defined(VTA_NO_SIMD) && defined(__GNUC__) && defined(__x86_64__)
+#define VTA_HAS_REDUCE_KERNELS
+#endif
+
+// Every step from reduce_f down to the kernels is forced inline. If any one of them is left as a
+// call, which GCC does at -O2 once there are around 64 arguments, each argument is spilled to the
+// stack to be passed by reference and the kernel ends up slower than foldl.
+#if defined(__GNUC__)
+#define VTA_DETAIL_ALWAYS_INLINE inline __attribute__((always_inline))
+#else
+#define VTA_DETAIL_ALWAYS_INLINE inline
+#endif
+
+namespace vta {
+
+/**************************************************************************************************
+ * Function Objects                                                                               *
+ **************************************************************************************************/
+
+struct minimum {
+	template <typename T>
+	constexpr T const& operator()(T const& lhs, T const& rhs) const noexcept {
+		return rhs < lhs ? rhs : lhs;
+	}
+};
+
+struct maximum {
+	template <typename T>
+	constexpr T const& operator()(T const& lhs, T const& rhs) const noexcept {
+		return lhs < rhs ? rhs : lhs;
+	}
+};
+
+namespace detail {
+
+/**************************************************************************************************
+ * Kernels                                                                                        *
+ **************************************************************************************************/
+
+// Each operation combines b into a, where a and b are either single values or vectors of values.
+// They take references rather than values because passing a 256-bit vector by value from a
+// function that is not compiled for AVX changes its ABI.
+struct simd_plus {
+	template <typename V>
+	VTA_DETAIL_ALWAYS_INLINE static void apply(V& a, V const& b) {
+		a = a + b;
+	}
+};
+
+struct simd_minimum {
+	template <typename V>
+	VTA_DETAIL_ALWAYS_INLINE static void apply(V& a, V const& b) {
+		a = b < a ? b : a;
+	}
+};
+
+struct simd_maximum {
+	template <typename V>
+	VTA_DETAIL_ALWAYS_INLINE static void apply(V& a, V const& b) {
+		a = a < b ? b : a;
+	}
+};
+
+struct simd_bit_and {
+	template <typename V>
+	VTA_DETAIL_ALWAYS_INLINE static void apply(V& a, V const& b) {
+		a = a & b;
+	}
+};
+
+struct simd_bit_or {
+	template <typename V>
+	VTA_DETAIL_ALWAYS_INLINE static void apply(V& a, V const& b) {
+		a = a | b;
+	}
+};
+
+struct simd_bit_xor {
+	template <typename V>
+	VTA_DETAIL_ALWAYS_INLINE static void apply(V& a, V const& b) {
+		a = a ^ b;
+	}
+};
+
+// Maps the function objects that reduce knows to be associative and commutative to the operation
+// used by the kernels. Any other function object has no operation and is never vectorized.
+template <typename Function>
+struct simd_operation {};
+
+template <typename T>
+struct simd_operation<std::plus<T>> {
+	using type = simd_plus;
+};
+
+template <typename T>
+struct simd_operation<std::bit_and<T>> {
+	using type = simd_bit_and;
+};
+
+template <typename T>
+struct simd_operation<std::bit_or<T>> {
+	using type = simd_bit_or;
+};
+
+template <typename T>
+struct simd_operation<std::bit_xor<T>> {
+	using type = simd_bit_xor;
+};
+
+template <>
+struct simd_operation<vta::minimum> {
+	using type = simd_minimum;
+};
+
+template <>
+struct simd_operation<vta::maximum> {
+	using type = simd_maximum;
+};
+
+#if defined(VTA_HAS_REDUCE_KERNELS)
+
+// Combines the lanes of a vector of Bytes bytes by combining its two halves, then the two halves of
+// that, and so on, rather than combining each lane into the result one at a time.
+template <typename Operation, typename T, std::size_t Bytes, bool = Bytes == 2 * sizeof(T)>
+struct lane_reduction {
+	typedef T vector __attribute__((vector_size(Bytes)));
+	typedef T half __attribute__((vector_size(Bytes / 2)));
+
+	VTA_DETAIL_ALWAYS_INLINE static T transform(vector const& v) {
+		half halves[2];
+		std::memcpy(halves, &v, Bytes);
+		Operation::apply(halves[0], halves[1]);
+		return lane_reduction<Operation, T, Bytes / 2>::transform(halves[0]);
+	}
+};
+
+template <typename Operation, typename T, std::size_t Bytes>
+struct lane_reduction<Operation, T, Bytes, true> {
+	typedef T vector __attribute__((vector_size(Bytes)));
+
+	VTA_DETAIL_ALWAYS_INLINE static T transform(vector const& v) {
+		T lanes[2];
+		std::memcpy(lanes, &v, Bytes);
+		Operation::apply(lanes[0], lanes[1]);
+		return lanes[0];
+	}
+};
+
+// Reduces a pack of N values of type T with vectors of Bytes bytes. The values are gathered
+// straight into vectors rather than copied into an array first, as a wide load of values that were
+// only just stored one at a time cannot be forwarded from the store buffer and stalls. The vectors
+// are then reduced as a balanced tree, followed by their lanes and any values left over.
+template <typename Operation, std::size_t Bytes, typename T, std::size_t N>
+struct vector_reduction {
+	typedef T vector __attribute__((vector_size(Bytes)));
+
+	static std::size_t const lanes = Bytes / sizeof(T);
+	static std::size_t const vectors = N / lanes;
+
+	template <typename Pack>
+	VTA_DETAIL_ALWAYS_INLINE static T transform(Pack const& pack) {
+		return finish(pack, std::integral_constant<bool, vectors != 0>{});
+	}
+
+private:
+	template <std::size_t V, typename Pack, std::size_t... Ls>
+	VTA_DETAIL_ALWAYS_INLINE static void load(vector& out, Pack const& pack, std::index_sequence<Ls...>) {
+		out = vector{get<V * lanes + Ls>(pack)...};
+	}
+
+	template <std::size_t Begin, std::size_t End, typename Pack>
+	VTA_DETAIL_ALWAYS_INLINE static void reduce_vectors(vector& out, Pack const& pack, std::true_type) {
+		load<Begin>(out, pack, std::make_index_sequence<lanes>{});
+	}
+
+	template <std::size_t Begin, std::size_t End, typename Pack>
+	VTA_DETAIL_ALWAYS_INLINE static void reduce_vectors(vector& out, Pack const& pack, std::false_type) {
+		constexpr std::size_t middle = Begin + (End - Begin) / 2;
+		vector right;
+		reduce_vectors<Begin, middle>(out, pack, std::integral_constant<bool, middle - Begin == 1>{});
+		reduce_vectors<middle, End>(right, pack, std::integral_constant<bool, End - middle == 1>{});
+		Operation::apply(out, right);
+	}
+
+	template <std::size_t First, typename Pack, std::size_t... Is>
+	VTA_DETAIL_ALWAYS_INLINE static void reduce_values(T& out, Pack const& pack, std::index_sequence<Is...>) {
+		int const expand[] = {0, (Operation::apply(out, get<First + Is>(pack)), 0)...};
+		static_cast<void>(expand);
+	}
+
+	template <typename Pack>
+	VTA_DETAIL_ALWAYS_INLINE static T finish(Pack const& pack, std::true_type) {
+		vector total;
+		reduce_vectors<0, vectors>(total, pack, std::integral_constant<bool, vectors == 1>{});
+
+		T result = lane_reduction<Operation, T, Bytes>::transform(total);
+		reduce_values<vectors * lanes>(result, pack, std::make_index_sequence<N - vectors * lanes>{});
+		return result;
+	}
+
+	template <typename Pack>
+	VTA_DETAIL_ALWAYS_INLINE static T finish(Pack const& pack, std::false_type) {
+		T result = get<0>(pack);
+		reduce_values<1>(result, pack, std::make_index_sequence<N - 1>{});
+		return result;
+	}
+};
+
+// Reduces the arguments, which all have type T, with the widest vectors the target supports. The
+// kernel is chosen at compile time rather than by checking the CPU at runtime, as a kernel compiled
+// for another target cannot be inlined and passing every argument to it costs more than AVX2 saves.
+template <typename Operation, typename T, typename... Args>
+VTA_DETAIL_ALWAYS_INLINE T reduce_values(Args const&... args) {
+	forward_pack<std::index_sequence_for<Args...>, Args const&...> const pack{args...};
+#if defined(__AVX2__)
+	return vector_reduction<Operation, 32, T, sizeof...(Args)>::transform(pack);
+#else
+	return vector_reduction<Operation, 16, T, sizeof...(Args)>::transform(pack);
+#endif
+}
+
+#endif
+
+/**************************************************************************************************
+ * Dispatch                                                                                       *
+ **************************************************************************************************/
+
+template <typename Function, typename = void>
+struct has_simd_operation : std::false_type {};
+
+template <typename Function>
+struct has_simd_operation<Function, decltype(static_cast<void>(std::declval<typename simd_operation<Function>::type>()))>
+: std::true_type {};
+
+#if defined(VTA_HAS_REDUCE_KERNELS)
+constexpr bool has_reduce_kernels = true;
+#else
+constexpr bool has_reduce_kernels = false;
+#endif
+
+// Below this many arguments the kernels are no faster than fold_tree
+constexpr std::size_t reduce_min_size = 8;
+
+// Whether f(args...) can be reduced by the kernels: every argument must decay to the same
+// arithmetic type T that fits in a vector lane, f must be a function object with a kernel
+// operation, and f(T, T) must return a T rather than, for instance, promoting it to int.
+template <bool Enable, typename Function, typename T>
+struct is_reducible_as {
+	static bool const value = false;
+};
+
+template <typename Function, typename T>
+struct is_reducible_as<true, Function, T> {
+	static bool const value = std::is_same<typename std::decay<decltype(std::declval<Function const&>()(std::declval<T const&>(), std::declval<T const&>()))>::type, T>::value;
+};
+
+template <typename Function, typename... Args>
+struct is_vectorizable {
+	using type = typename std::decay<head_t<Args...>>::type;
+
+	static bool const value = is_reducible_as<has_reduce_kernels
+	                                          && sizeof...(Args) >= reduce_min_size
+	                                          && are_same_after<std::decay, Args...>::value
+	                                          && std::is_arithmetic<type>::value
+	                                          && !std::is_same<type, bool>::value
+	                                          && !std::is_same<type, long double>::value
+	                                          && has_simd_operation<Function>::value,
+	                                          Function, type>::value;
+};
+
+// Both paths return a value, as the kernels combine copies of the arguments, so that the type of
+// reduce(f)(args...) does not depend on how many arguments there are
+template <bool Vectorize>
+struct reduce_helper {
+	template <typename Function, typename... Args>
+	static auto transform(Function& f, Args&&... args)
+	  -> typename std::decay<decltype(vta::fold_tree(f)(std::forward<Args>(args)...))>::type {
+		return vta::fold_tree(f)(std::forward<Args>(args)...);
+	}
+};
+
+#if defined(VTA_HAS_REDUCE_KERNELS)
+
+template <>
+struct reduce_helper<true> {
+	template <typename Function, typename... Args>
+	VTA_DETAIL_ALWAYS_INLINE static typename std::decay<head_t<Args...>>::type transform(Function&, Args&&... args) {
+		using operation = typename simd_operation<typename std::remove_const<Function>::type>::type;
+		return reduce_values<operation, typename std::decay<head_t<Args...>>::type>(args...);
+	}
+};
+
+#endif
+
+} // namespace detail
+
+/**************************************************************************************************
+ * Functions                                                                                      *
+ **************************************************************************************************/
+
+template <typename Function>
+class reduce_f {
+	Function mF;
+
+public:
+	constexpr reduce_f(Function f)
+	: mF(std::move(f)) {
+	}
+
+	template <typename First, typename... Args>
+	VTA_DETAIL_ALWAYS_INLINE decltype(auto) operator()(First&& first, Args&&... args) const {
+		return detail::reduce_helper<detail::is_vectorizable<Function, First, Args...>::value>::transform(
+		    mF, std::forward<First>(first), std::forward<Args>(args)...);
+	}
+
+	template <typename First, typename... Args>
+	VTA_DETAIL_ALWAYS_INLINE decltype(auto) operator()(First&& first, Args&&... args) {
+		return detail::reduce_helper<detail::is_vectorizable<Function, First, Args...>::value>::transform(
+		    mF, std::forward<First>(first), std::forward<Args>(args)...);
+	}
+};
+
+template <typename Function>
+constexpr reduce_f<typename std::remove_reference<Function>::type> reduce(Function&& f) {
+	return {std::forward<Function>(f)};
+}
+
+}
+
+#undef VTA_DETAIL_ALWAYS_INLINE
+
+#endif
@@ -0,0 +1,305 @@
+/******************************************************************//**
+ * \file   soa_vector.hpp
+ * \author Elliot Goodrich
+ *
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *********************************************************************/
+
+#ifndef INCLUDE_GUARD_577B6453_E6B0_47BE_A837_1AA51B39D5AD
+#define INCLUDE_GUARD_577B6453_E6B0_47BE_A837_1AA51B39D5AD
+
+#include "algorithms.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace vta {
+
+namespace detail {
+
+// Every column starts on a cache line, or on a stricter alignment if T needs one
+template <typename T>
+struct column_alignment : std::integral_constant<std::size_t, (alignof(T) > 64 ? alignof(T) : 64)> {};
+
+// Allocates storage aligned to Alignment bytes by over-allocating with operator new and keeping the
+// pointer that it returned just before the aligned storage
+template <typename T, std::size_t Alignment>
+struct aligned_allocator {
+	static_assert(Alignment != 0 && (Alignment & (Alignment - 1)) == 0, "Alignment must be a power of 2");
+	static_assert(Alignment >= alignof(void*), "Alignment must leave room for the original pointer");
+
+	typedef T value_type;
+
+	template <typename U>
+	struct rebind {
+		typedef aligned_allocator<U, Alignment> other;
+	};
+
+	aligned_allocator() noexcept = default;
+
+	template <typename U>
+	constexpr aligned_allocator(aligned_allocator<U, Alignment> const&) noexcept {
+	}
+
+	T* allocate(std::size_t n) {
+		std::size_t const extra = Alignment + sizeof(void*);
+		if(n > (std::numeric_limits<std::size_t>::max() - extra) / sizeof(T)) {
+			throw std::bad_alloc{};
+		}
+
+		void* const original = ::operator new(n * sizeof(T) + extra);
+		std::uintptr_t const first = reinterpret_cast<std::uintptr_t>(original) + sizeof(void*);
+		void* const aligned = reinterpret_cast<void*>((first + Alignment - 1) & ~(Alignment - 1));
+		static_cast<void**>(aligned)[-1] = original;
+		return static_cast<T*>(aligned);
+	}
+
+	void deallocate(T* p, std::size_t) noexcept {
+		::operator delete(reinterpret_cast<void**>(p)[-1]);
+	}
+};
+
+template <typename T, typename U, std::size_t Alignment>
+constexpr bool operator==(aligned_allocator<T, Alignment> const&,
+                          aligned_allocator<U, Alignment> const&) noexcept {
+	return true;
+}
+
+template <typename T, typename U, std::size_t Alignment>
+constexpr bool operator!=(aligned_allocator<T, Alignment> const&,
+                          aligned_allocator<U, Alignment> const&) noexcept {
+	return false;
+}
+
+template <typename T>
+using column_vector = std::vector<T, aligned_allocator<T, column_alignment<T>::value>>;
+
+template <typename T, std::size_t I>
+std::integral_constant<std::size_t, I> select_position(indexed_key<I, T>*);
+
+// The position of T in Args..., which must appear exactly once
+template <typename T, typename... Args>
+using position_of_type = decltype(
+  select_position<T>(static_cast<type_set<std::index_sequence_for<Args...>, Args...>*>(nullptr)));
+
+} // namespace detail
+
+/** A contiguous range of the values in one column of a soa_vector */
+template <typename T>
+class soa_column {
+	T* mFirst;
+	std::size_t mSize;
+
+public:
+	typedef T value_type;
+	typedef T* iterator;
+
+	constexpr soa_column(T* first, std::size_t size) noexcept
+	: mFirst(first)
+	, mSize(size) {
+	}
+
+	constexpr T* begin() const noexcept {
+		return mFirst;
+	}
+
+	constexpr T* end() const noexcept {
+		return mFirst + mSize;
+	}
+
+	constexpr T* data() const noexcept {
+		return mFirst;
+	}
+
+	constexpr std::size_t size() const noexcept {
+		return mSize;
+	}
+
+	constexpr bool empty() const noexcept {
+		return mSize == 0;
+	}
+
+	constexpr T& operator[](std::size_t i) const noexcept {
+		return mFirst[i];
+	}
+};
+
+/** Refers to the elements at one index of every column of a soa_vector, which is Vector or
+    Vector const */
+template <typename Vector>
+class soa_row {
+	Vector* mVector;
+	std::size_t mIndex;
+
+public:
+	constexpr soa_row(Vector& vector, std::size_t index) noexcept
+	: mVector(&vector)
+	, mIndex(index) {
+	}
+
+	constexpr std::size_t index() const noexcept {
+		return mIndex;
+	}
+
+	template <std::size_t I, typename V>
+	friend constexpr decltype(auto) get(soa_row<V> const& row) noexcept;
+};
+
+/** The element in column I of row */
+template <std::size_t I, typename Vector>
+constexpr decltype(auto) get(soa_row<Vector> const& row) noexcept {
+	return row.mVector->template column<I>()[row.mIndex];
+}
+
+/** A sequence of records of the types Ts..., stored as one contiguous array per type so that reading
+    one field of every record only reads the memory of that field */
+template <typename... Ts>
+class soa_vector {
+	static_assert(sizeof...(Ts) != 0, "soa_vector needs at least one column");
+
+	std::tuple<detail::column_vector<Ts>...> mColumns;
+
+	template <std::size_t... Is, typename... Us>
+	void emplace(std::index_sequence<Is...>, Us&&... values) {
+		std::size_t const old_size = size();
+		try {
+			int const expand[] = {0, (std::get<Is>(mColumns).emplace_back(std::forward<Us>(values)), 0)...};
+			static_cast<void>(expand);
+		} catch(...) {
+			// Leave every column with the same number of elements as before
+			vta::map([old_size](auto& column) {
+				while(column.size() > old_size) {
+					column.pop_back();
+				}
+			}, mColumns);
+			throw;
+		}
+	}
+
+public:
+	/** The type of column I */
+	template <std::size_t I>
+	using element_t = typename at_t<static_cast<int>(I)>::template type<Ts...>;
+
+	typedef soa_row<soa_vector> reference;
+	typedef soa_row<soa_vector const> const_reference;
+
+	static std::size_t const columns = sizeof...(Ts);
+
+	std::size_t size() const noexcept {
+		return std::get<0>(mColumns).size();
+	}
+
+	bool empty() const noexcept {
+		return size() == 0;
+	}
+
+	void reserve(std::size_t n) {
+		vta::map([n](auto& column) { column.reserve(n); }, mColumns);
+	}
+
+	void clear() noexcept {
+		vta::map([](auto& column) { column.clear(); }, mColumns);
+	}
+
+	// Appends a record with each column constructed from the argument in the same position. If a
+	// constructor throws, the soa_vector is left as it was.
+	template <typename... Us,
+	          typename = std::enable_if_t<sizeof...(Us) == sizeof...(Ts)
+	            && detail::all_true<std::is_constructible<Ts, Us&&>::value...>::value>>
+	void emplace_back(Us&&... values) {
+		emplace(std::index_sequence_for<Ts...>{}, std::forward<Us>(values)...);
+	}
+
+	void push_back(Ts const&... values) {
+		emplace_back(values...);
+	}
+
+	void push_back(Ts&&... values) {
+		emplace_back(std::move(values)...);
+	}
+
+	void pop_back() {
+		vta::map([](auto& column) { column.pop_back(); }, mColumns);
+	}
+
+	reference operator[](std::size_t i) noexcept {
+		return {*this, i};
+	}
+
+	const_reference operator[](std::size_t i) const noexcept {
+		return {*this, i};
+	}
+
+	template <std::size_t I>
+	soa_column<element_t<I>> column() noexcept {
+		auto& column = std::get<I>(mColumns);
+		return {column.data(), column.size()};
+	}
+
+	template <std::size_t I>
+	soa_column<element_t<I> const> column() const noexcept {
+		auto const& column = std::get<I>(mColumns);
+		return {column.data(), column.size()};
+	}
+
+	// The column of type T, which can only be named by type if it appears once in Ts...
+	template <typename T>
+	soa_column<T> column() noexcept {
+		static_assert(are_unique<Ts...>::value, "Columns can only be found by type if the types are unique");
+		return column<detail::position_of_type<T, Ts...>::value>();
+	}
+
+	template <typename T>
+	soa_column<T const> column() const noexcept {
+		static_assert(are_unique<Ts...>::value, "Columns can only be found by type if the types are unique");
+		return column<detail::position_of_type<T, Ts...>::value>();
+	}
+};
+
+template <typename... Ts>
+std::size_t const soa_vector<Ts...>::columns;
+
+}
+
+namespace std {
+
+template <typename Vector>
+struct tuple_size<vta::soa_row<Vector>> : integral_constant<size_t, remove_const_t<Vector>::columns> {};
+
+template <size_t I, typename Vector>
+struct tuple_element<I, vta::soa_row<Vector>> {
+	typedef decltype(vta::get<I>(declval<vta::soa_row<Vector> const&>())) type;
+};
+
+}
+
+#endif
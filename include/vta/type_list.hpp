@@ -0,0 +1,202 @@
+/******************************************************************//**
+ * \file   type_list.hpp
+ * \author Elliot Goodrich
+ *
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *********************************************************************/
+
+#ifndef INCLUDE_GUARD_25CC53E2_9A40_40AA_9191_023717922D9C
+#define INCLUDE_GUARD_25CC53E2_9A40_40AA_9191_023717922D9C
+
+#include "algorithms.hpp"
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace vta {
+
+/**************************************************************************************************
+ * Type Lists                                                                                     *
+ **************************************************************************************************/
+
+// A list of types to compute with when only the types, and not any values, are needed. Each
+// algorithm is an alias template that takes the list as its first parameter, so nothing is
+// computed for a type_list until it is asked for and no function is ever instantiated. It is the
+// same template that the predicates use, so lists from either can be used together.
+template <typename... Ts>
+using type_list = detail::type_list<Ts...>;
+
+namespace detail {
+
+// The type_list of the types in Ts... at each of Positions
+template <typename Positions, typename... Ts>
+struct select_types;
+
+template <std::size_t... Positions, typename... Ts>
+struct select_types<std::index_sequence<Positions...>, Ts...> {
+	typedef vta::type_list<type_at_position<Positions, Ts...>...> type;
+};
+
+template <typename List, typename Transformation>
+struct transform_list;
+
+template <typename... Ts, typename Transformation>
+struct transform_list<vta::type_list<Ts...>, Transformation> {
+	typedef typename Transformation::template positions<Ts...> Map;
+	typedef typename select_types<typename generate_positions<Map>::type, Ts...>::type type;
+};
+
+// The position of the first T in Ts..., or sizeof...(Ts) if there is none
+template <typename T, typename... Ts>
+constexpr std::size_t first_index() noexcept {
+	bool const same[] = {std::is_same<T, Ts>::value..., false};
+	std::size_t i = 0;
+	while(i < sizeof...(Ts) && !same[i]) {
+		++i;
+	}
+	return i;
+}
+
+// The address of type_id<T>::value identifies T in constant expressions, so that the types in a
+// pack can be compared with each other in a constexpr loop instead of by instantiating a template
+// for each pair
+template <typename T>
+struct type_id {
+	constexpr static char value = 0;
+};
+
+template <typename T>
+constexpr char type_id<T>::value;
+
+// The position of the first of each type in Ts..., in order. The ids can only be compared for
+// equality, not ordered, so each type is compared with those before it. This takes O(N^2) steps,
+// and GCC's default -fconstexpr-ops-limit is reached at about 2000 distinct types.
+template <typename... Ts>
+constexpr position_array<sizeof...(Ts)> first_positions() noexcept {
+	char const* const ids[] = {&type_id<Ts>::value..., nullptr};
+	position_array<sizeof...(Ts)> result{{}, 0};
+	for(std::size_t i = 0; i < sizeof...(Ts); ++i) {
+		std::size_t j = 0;
+		while(j < i && ids[j] != ids[i]) {
+			++j;
+		}
+		if(j == i) {
+			result.values[result.size++] = i;
+		}
+	}
+	return result;
+}
+
+template <typename... Ts>
+struct unique_positions {
+	constexpr static position_array<sizeof...(Ts)> firsts = first_positions<Ts...>();
+	static std::size_t const size = firsts.size;
+
+	constexpr static std::size_t at(std::size_t i) noexcept {
+		return firsts.values[i];
+	}
+};
+
+template <typename... Ts>
+constexpr position_array<sizeof...(Ts)> unique_positions<Ts...>::firsts;
+
+template <typename List>
+struct unique_list;
+
+template <typename... Ts>
+struct unique_list<vta::type_list<Ts...>> {
+	typedef unique_positions<Ts...> Map;
+	typedef typename select_types<typename generate_positions<Map>::type, Ts...>::type type;
+};
+
+template <typename List, int N>
+struct list_at;
+
+template <typename... Ts, int N>
+struct list_at<vta::type_list<Ts...>, N> {
+	typedef type_at_position<pack_index<N, sizeof...(Ts)>::value, Ts...> type;
+};
+
+template <typename List, typename T>
+struct list_index_of;
+
+template <typename... Ts, typename T>
+struct list_index_of<vta::type_list<Ts...>, T> {
+	static std::size_t const value = first_index<T, Ts...>();
+	static_assert(value < sizeof...(Ts), "T is not in the type_list");
+};
+
+template <typename List, template <class...> class Template>
+struct apply_list;
+
+template <typename... Ts, template <class...> class Template>
+struct apply_list<vta::type_list<Ts...>, Template> {
+	typedef Template<Ts...> type;
+};
+
+} // namespace detail
+
+/** The types in List after a positional transformation such as reverse, filter, permute, swap or
+    slice. The types selected are exactly those of the arguments that forward_after<Transformation>
+    would forward, in the same order. */
+template <typename List, typename Transformation>
+using transform_t = typename detail::transform_list<List, Transformation>::type;
+
+template <typename List>
+using reverse_t = transform_t<List, vta::reverse>;
+
+/** The types T in List for which Predicate<T>::value is true */
+template <typename List, template <class> class Predicate>
+using filter_t = transform_t<List, vta::filter<Predicate>>;
+
+template <typename List, int... Ns>
+using permute_t = transform_t<List, vta::permute<Ns...>>;
+
+/** The types at positions N, N + 1, ..., M of List */
+template <typename List, int N, int M>
+using slice_t = transform_t<List, vta::slice<N, M>>;
+
+/** The type at position N of List, counted from the end if N is negative */
+template <typename List, int N>
+using list_at_t = typename detail::list_at<List, N>::type;
+
+/** The position of the first T in List */
+template <typename List, typename T>
+struct index_of {
+	static std::size_t const value = detail::list_index_of<List, T>::value;
+};
+
+/** The first of each type in List, in the order they first appear */
+template <typename List>
+using unique_t = typename detail::unique_list<List>::type;
+
+/** Template<Ts...> for the types Ts... in List, e.g. apply_t<List, std::tuple> */
+template <typename List, template <class...> class Template>
+using apply_t = typename detail::apply_list<List, Template>::type;
+
+}
+
+#endif
@@ -1,14 +1,30 @@
 #include "vta/algorithms.hpp"
+#include "vta/array.hpp"
+
+#include "test_helpers.hpp"
 
 #include <boost/test/unit_test.hpp>
 
 #include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <functional>
 #include <iostream>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
 #include <type_traits>
 #include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 namespace {
 
+using vta_test::string_concat;
+
 struct printer {
 	printer(std::ostream& str)
 	: m_str{&str} {
@@ -22,23 +38,413 @@ struct printer {
 	std::ostream* m_str;
 };
 
-struct string_concat {
+struct is_positive_int {
+	bool operator()(int x) const {
+		return x > 0;
+	}
+
+	template <typename T>
+	bool operator()(T const&) const {
+		return false;
+	}
+};
+
+struct collector {
+	collector(std::vector<int>& ints)
+	: m_ints{&ints} {
+	}
+
+	void operator()(int i) {
+		m_ints->push_back(i);
+	}
+
+	std::vector<int>* m_ints;
+};
+
+// Returns the result of forwarding 0, 1, ..., N - 1 after Transformation
+template <typename Transformation, std::size_t... Is>
+std::vector<int> transformed_sequence(std::index_sequence<Is...>) {
+	std::vector<int> ints;
+	vta::forward_after<Transformation>(vta::map(collector{ints}))(static_cast<int>(Is)...);
+	return ints;
+}
+
+// An int at every position that is a multiple of Period and a double everywhere else
+template <std::size_t I, std::size_t Period>
+using int_every = std::conditional_t<I % Period == 0, int, double>;
+
+// Returns the ints left after filtering 0, 1, ..., N - 1 passed as int_every<I, Period>
+template <std::size_t Period, std::size_t... Is>
+std::vector<int> filtered_ints(std::index_sequence<Is...>) {
+	std::vector<int> ints;
+	vta::forward_after<vta::filter<std::is_integral>>(vta::map(collector{ints}))(
+	  static_cast<int_every<Is, Period>>(Is)...);
+	return ints;
+}
+
+template <std::size_t Period>
+std::vector<int> multiples_below(int n) {
+	std::vector<int> ints;
+	for(int i = 0; i < n; i += static_cast<int>(Period)) {
+		ints.push_back(i);
+	}
+	return ints;
+}
+
+struct subtract {
+	constexpr int operator()(int lhs, int rhs) const {
+		return lhs - rhs;
+	}
+};
+
+struct add {
+	constexpr int operator()(int lhs, int rhs) const {
+		return lhs + rhs;
+	}
+};
+
+struct minimum {
+	template <typename T>
+	constexpr T operator()(T lhs, T rhs) const {
+		return rhs < lhs ? rhs : lhs;
+	}
+};
+
+struct maximum {
+	template <typename T>
+	constexpr T operator()(T lhs, T rhs) const {
+		return lhs < rhs ? rhs : lhs;
+	}
+};
+
+// Compares only by key, so that equal keys can be told apart by id
+struct keyed {
+	int key;
+	int id;
+
+	constexpr bool operator<(keyed const& rhs) const {
+		return key < rhs.key;
+	}
+};
+
+struct bracket {
 	template <typename LHS, typename RHS>
 	std::string operator()(LHS const& lhs, RHS const& rhs) const {
 		std::stringstream ss;
-		ss << lhs << rhs;
+		ss << '(' << lhs << rhs << ')';
 		return ss.str();
 	}
 };
 
-struct is_positive_int {
-	bool operator()(int x) const {
-		return x > 0;
+// Sums lvalues, but gives a string for two rvalues
+struct lvalue_sum {
+	int operator()(int const& lhs, int& rhs) const {
+		return lhs + rhs;
+	}
+
+	std::string operator()(int&&, int&&) const {
+		return "rvalues";
+	}
+};
+
+template <std::size_t I>
+struct tag {};
+
+template <std::size_t I, typename T>
+using always = T;
+
+// Whether tag<0>, tag<1>, ..., tag<N - 1>, followed by Extra..., are unique
+template <typename... Extra, std::size_t... Is>
+constexpr bool unique_tags(std::index_sequence<Is...>) {
+	return vta::are_unique<tag<Is>..., Extra...>::value;
+}
+
+template <int... Extra, std::size_t... Is>
+constexpr bool unique_ints(std::index_sequence<Is...>) {
+	return vta::are_unique_ints<static_cast<int>(Is)..., Extra...>::value;
+}
+
+template <typename T, typename... Extra, std::size_t... Is>
+constexpr bool same_types(std::index_sequence<Is...>) {
+	return vta::are_same<always<Is, T>..., Extra...>::value;
+}
+
+template <typename T>
+struct size_key : std::integral_constant<std::size_t, sizeof(std::decay_t<T>)> {};
+
+template <typename T>
+struct descending_tag;
+
+template <std::size_t I>
+struct descending_tag<tag<I>> : std::integral_constant<int, -static_cast<int>(I)> {};
+
+template <typename T>
+struct remainder_of_3;
+
+template <std::size_t I>
+struct remainder_of_3<tag<I>> : std::integral_constant<std::size_t, I % 3> {};
+
+struct collect_tags {
+	std::vector<std::size_t>* indices;
+
+	template <std::size_t... Is>
+	void operator()(tag<Is>...) const {
+		*indices = {Is...};
 	}
+};
 
+// Returns the I of each tag<I> forwarded after sorting tag<0>, tag<1>, ..., tag<N - 1> by Key
+template <template <class> class Key, std::size_t... Is>
+std::vector<std::size_t> sorted_tags(std::index_sequence<Is...>) {
+	std::vector<std::size_t> indices;
+	vta::forward_after<vta::sort_by<Key>>(collect_tags{&indices})(tag<Is>{}...);
+	return indices;
+}
+
+// Returns the flags it is called with as the bits of an int, with the first flag most significant
+struct flags_to_int {
+	template <typename... Flags>
+	constexpr int operator()(Flags...) const {
+		bool const flags[] = {false, Flags::value...};
+		int result = 0;
+		for(bool flag : flags) {
+			result = result * 2 + flag;
+		}
+		return result;
+	}
+};
+
+// Passes the bits of mask to dispatch_bools as sizeof...(Is) flags
+template <std::size_t... Is>
+int dispatch_mask(int mask, std::index_sequence<Is...>) {
+	return vta::dispatch_bools(flags_to_int{}, ((mask >> (sizeof...(Is) - 1 - Is)) & 1) != 0 ...);
+}
+
+// Returns the indices it is called with as the decimal digits of an int
+struct indices_to_int {
+	template <int... Is>
+	constexpr int operator()(std::integral_constant<int, Is>...) const {
+		int const indices[] = {0, Is...};
+		int result = 0;
+		for(int i : indices) {
+			result = result * 10 + i;
+		}
+		return result;
+	}
+};
+
+constexpr indices_to_int constexpr_indices_to_int{};
+
+template <std::size_t K, std::size_t N, std::size_t... Is>
+int nth_of(std::array<int, N> const& values, std::index_sequence<Is...>) {
+	return vta::nth<K>(values[Is]...);
+}
+
+// Whether sort and nth agree with std::sort for every input of N zeros and ones, which by the 0-1
+// principle means that they do for every input
+template <std::size_t... Is>
+bool sorts_zeros_and_ones(std::index_sequence<Is...> sequence) {
+	std::size_t const n = sizeof...(Is);
+	for(unsigned mask = 0; mask < (1u << n); ++mask) {
+		std::array<int, n> const values{{static_cast<int>((mask >> Is) & 1)...}};
+		std::array<int, n> expected = values;
+		std::sort(expected.begin(), expected.end());
+		std::array<int, n> const nths{{nth_of<Is>(values, sequence)...}};
+		if(vta::sort(values[Is]...) != expected || nths != expected) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// Whether sort agrees with std::sort for some pseudo-random inputs of N values
+template <std::size_t... Is>
+bool sorts_random_values(std::index_sequence<Is...>) {
+	std::uint32_t state = 12345;
+	for(int i = 0; i < 100; ++i) {
+		std::array<std::uint32_t, sizeof...(Is)> values;
+		for(std::uint32_t& x : values) {
+			state = state * 1664525u + 1013904223u;
+			x = state >> 20;
+		}
+		std::array<std::uint32_t, sizeof...(Is)> expected = values;
+		std::sort(expected.begin(), expected.end());
+		std::uint32_t const median = expected[(sizeof...(Is) - 1) / 2];
+		if(vta::sort(values[Is]...) != expected || vta::median(values[Is]...) != median) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// Returns the sum of 0, 1, ..., N - 1 computed by fold_tree
+template <std::size_t... Is>
+constexpr int tree_sum(std::index_sequence<Is...>) {
+	return vta::add_const(vta::fold_tree(add{}))(static_cast<int>(Is)...);
+}
+
+// Returns 0 - 1 - ... - (N - 1) computed by foldl
+template <std::size_t... Is>
+constexpr int left_difference(std::index_sequence<Is...>) {
+	return vta::add_const(vta::foldl(subtract{}))(static_cast<int>(Is)...);
+}
+
+// Returns 0 - (1 - (... - (N - 1))) computed by foldr
+template <std::size_t... Is>
+constexpr int right_difference(std::index_sequence<Is...>) {
+	return vta::add_const(vta::foldr(subtract{}))(static_cast<int>(Is)...);
+}
+
+struct identity {
 	template <typename T>
-	bool operator()(T const&) const {
-		return false;
+	constexpr T&& operator()(T&& t) const noexcept {
+		return std::forward<T>(t);
+	}
+};
+
+// Returns the arguments 0, 1, ..., N - 1 visited at every index by visit_at
+template <std::size_t... Is>
+std::vector<int> visit_every(std::index_sequence<Is...>) {
+	std::vector<int> visited;
+	for(std::size_t i = 0; i < sizeof...(Is); ++i) {
+		visited.push_back(vta::visit_at(i, identity{}, static_cast<int>(Is)...));
+	}
+	return visited;
+}
+
+// Returns the sums of each window of N adjacent arguments in 0, 1, ..., M - 1
+template <unsigned N, std::size_t... Is>
+std::vector<int> window_sums(std::index_sequence<Is...>) {
+	std::vector<int> sums;
+	vta::adjacent_map<N>([&sums](auto const&... window) {
+		sums.push_back(vta::add_const(vta::foldl(add{}))(0, window...));
+	})(static_cast<int>(Is)...);
+	return sums;
+}
+
+std::vector<int> expected_window_sums(int n, int m) {
+	std::vector<int> sums;
+	for(int begin = 0; begin + n <= m; ++begin) {
+		sums.push_back(n * begin + n * (n - 1) / 2);
+	}
+	return sums;
+}
+
+// Overloads operator& to return something other than its address
+struct hides_address {
+	int value = 0;
+
+	int operator&() const {
+		return 0;
+	}
+};
+
+// Counts the number of times any counted object is copied or moved
+struct counted {
+	static int copies;
+	static int moves;
+
+	static void reset() {
+		copies = 0;
+		moves = 0;
+	}
+
+	counted() = default;
+
+	counted(counted const&) {
+		++copies;
+	}
+
+	counted(counted&&) {
+		++moves;
+	}
+};
+
+int counted::copies = 0;
+int counted::moves = 0;
+
+// A stateful function that counts how many times it is copied, moved and called
+struct counting_function {
+	static int copies;
+	static int moves;
+
+	static void reset() {
+		copies = 0;
+		moves = 0;
+	}
+
+	int calls = 0;
+
+	counting_function() = default;
+
+	counting_function(counting_function const& other)
+	: calls{other.calls} {
+		++copies;
+	}
+
+	counting_function(counting_function&& other)
+	: calls{other.calls} {
+		++moves;
+	}
+
+	template <typename... Args>
+	int operator()(Args&&...) {
+		return ++calls;
+	}
+};
+
+int counting_function::copies = 0;
+int counting_function::moves = 0;
+
+constexpr subtract constexpr_subtract{};
+
+struct return_first {
+	template <typename First, typename... Args>
+	First&& operator()(First&& first, Args&&...) const {
+		return std::forward<First>(first);
+	}
+};
+
+// Returns a new counted object from any two arguments
+struct make_counted {
+	template <typename LHS, typename RHS>
+	counted operator()(LHS&&, RHS&&) const {
+		return counted{};
+	}
+};
+
+struct add_into {
+	constexpr void operator()(int& total, int x) const {
+		total += x;
+	}
+};
+
+template <std::size_t... Is>
+constexpr int sum_into(std::index_sequence<Is...>) {
+	int total = 0;
+	vta::add_const(vta::foldl_into(total, add_into{}))(static_cast<int>(Is)...);
+	return total;
+}
+
+// Counts the number of times it is called and returns whether the argument is true
+struct count_calls {
+	int* calls;
+
+	bool operator()(bool b) const {
+		++*calls;
+		return b;
+	}
+};
+
+template <typename T>
+struct is_counted : std::is_same<std::decay_t<T>, counted> {};
+
+template <typename T>
+struct is_int : std::is_same<std::decay_t<T>, int> {};
+
+struct take_by_value {
+	template <typename... Args>
+	void operator()(Args...) const {
 	}
 };
 
@@ -75,6 +481,19 @@ BOOST_AUTO_TEST_CASE(are_same) {
 	static_assert(!vta::are_same<int&&, int&>::value, "");
 	static_assert(!vta::are_same<const int, int>::value, "");
 	static_assert(!vta::are_same<volatile int, int>::value, "");
+	static_assert(vta::are_same<void, void>::value, "");
+	static_assert(!vta::are_same<int[3], int[4], int[3]>::value, "");
+	static_assert(!vta::are_same<int, int, int, float, int>::value, "");
+
+	// Every arity is an integral_constant
+	static_assert(std::is_base_of<std::true_type, vta::are_same<>>::value, "");
+	static_assert(std::is_base_of<std::true_type, vta::are_same<int>>::value, "");
+	static_assert(std::is_base_of<std::false_type, vta::are_same<int, float>>::value, "");
+	static_assert(vta::are_same<int, int>{}, "");
+
+	static_assert(same_types<int>(std::make_index_sequence<300>{}), "");
+	static_assert(!same_types<int, float>(std::make_index_sequence<300>{}), "");
+	static_assert(!same_types<int, int&>(std::make_index_sequence<300>{}), "");
 }
 
 BOOST_AUTO_TEST_CASE(are_same_after) {
@@ -93,6 +512,16 @@ BOOST_AUTO_TEST_CASE(are_unique_ints) {
 	static_assert(vta::are_unique_ints<1, 2, 3, 4, 5>::value, "");
 	static_assert(!vta::are_unique_ints<1, 2, 3, 1, 5>::value, "");
 	static_assert(!vta::are_unique_ints<2, 3, 4, 5, 6, 5>::value, "");
+	static_assert(vta::are_unique_ints<9, -4, 7, 0, 3, -8, 5, 1>::value, "");
+	static_assert(!vta::are_unique_ints<9, -4, 7, 0, 3, -8, 5, 9>::value, "");
+	static_assert(!vta::are_unique_ints<-8, -4, 7, 0, 3, -8, 5, 1>::value, "");
+	static_assert(std::is_base_of<std::true_type, vta::are_unique_ints<1>>::value, "");
+	static_assert(std::is_base_of<std::false_type, vta::are_unique_ints<1, 1>>::value, "");
+
+	static_assert(unique_ints(std::make_index_sequence<300>{}), "");
+	static_assert(unique_ints<-1, 300>(std::make_index_sequence<300>{}), "");
+	static_assert(!unique_ints<150>(std::make_index_sequence<300>{}), "");
+	static_assert(!unique_ints<0>(std::make_index_sequence<300>{}), "");
 }
 
 BOOST_AUTO_TEST_CASE(are_unique) {
@@ -100,11 +529,21 @@ BOOST_AUTO_TEST_CASE(are_unique) {
 	static_assert(vta::are_unique<int>::value, "");
 	static_assert(vta::are_unique<int, float>::value, "");
 	static_assert(!vta::are_unique<int, int>::value, "");
+	static_assert(std::is_base_of<std::true_type, vta::are_unique<int>>::value, "");
+	static_assert(std::is_base_of<std::false_type, vta::are_unique<int, int>>::value, "");
 	static_assert(vta::are_unique<int, int&>::value, "");
 	static_assert(vta::are_unique<int&&, int&>::value, "");
 	static_assert(vta::are_unique<int, float>::value, "");
 	static_assert(!vta::are_unique<int, float, int>::value, "");
 	static_assert(vta::are_unique<int, float, char>::value, "");
+	static_assert(vta::are_unique<void, int[3], int[4], int(), int(&)()>::value, "");
+	static_assert(!vta::are_unique<void, int[3], void>::value, "");
+
+	static_assert(unique_tags(std::make_index_sequence<300>{}), "");
+	static_assert(unique_tags<int, float>(std::make_index_sequence<300>{}), "");
+	static_assert(!unique_tags<tag<0>>(std::make_index_sequence<300>{}), "");
+	static_assert(!unique_tags<tag<299>>(std::make_index_sequence<300>{}), "");
+	static_assert(!unique_tags<int, float, int>(std::make_index_sequence<300>{}), "");
 }
 
 BOOST_AUTO_TEST_CASE(are_unique_after) {
@@ -127,6 +566,9 @@ BOOST_AUTO_TEST_CASE(last) {
 	BOOST_CHECK_EQUAL(vta::last(0, 1), 1);
 	BOOST_CHECK_EQUAL(vta::last(0, 1, 2), 2);
 	BOOST_CHECK_EQUAL(vta::last(1, "2", 3), 3);
+	BOOST_CHECK_EQUAL(vta::last(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+	                            16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31), 31);
+	static_assert(vta::last(1, '2', 3) == 3, "");
 }
 
 BOOST_AUTO_TEST_CASE(at) {
@@ -138,6 +580,279 @@ BOOST_AUTO_TEST_CASE(at) {
 	BOOST_CHECK_EQUAL(vta::at<-2>(1, '2', 3u, 4.5, "six"), 4.5);
 	BOOST_CHECK_EQUAL(vta::at<4>(1, '2', 3u, 4.5, "six"), std::string{"six"});
 	BOOST_CHECK_EQUAL(vta::at<-1>(1, '2', 3u, 4.5, "six"), std::string{"six"});
+	BOOST_CHECK_EQUAL(vta::at<20>(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+	                              16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31), 20);
+	BOOST_CHECK_EQUAL(vta::at<-32>(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+	                               16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31), 0);
+	static_assert(vta::at<1>(1, '2', 3) == '2', "");
+	static_assert(vta::at<-3>(1, '2', 3) == 1, "");
+}
+
+BOOST_AUTO_TEST_CASE(visit_at) {
+	std::string const printed[] = {"1", "2", "3", "4.5", "six"};
+	for(std::size_t i = 0; i < 5; ++i) {
+		std::stringstream ss;
+		vta::visit_at(i, printer{ss}, 1, '2', 3u, 4.5, "six");
+		BOOST_CHECK_EQUAL(ss.str(), printed[i]);
+	}
+
+	std::stringstream ss;
+	BOOST_CHECK_THROW(vta::visit_at(5, printer{ss}, 1, '2', 3u, 4.5, "six"), std::out_of_range);
+	BOOST_CHECK_THROW(vta::visit_at(static_cast<std::size_t>(-1), printer{ss}, 1), std::out_of_range);
+	BOOST_CHECK_EQUAL(ss.str(), "");
+
+	// Arguments are forwarded with their value category and the result is returned as it is
+	int a = 1;
+	int b = 2;
+	static_assert(std::is_same<decltype(vta::visit_at(0, identity{}, a, b)), int&>::value, "");
+	BOOST_CHECK_EQUAL(&vta::visit_at(1, identity{}, a, b), &b);
+	BOOST_CHECK_EQUAL(vta::visit_at(1, [](auto&& x) { return x.size(); }, std::string{"a"}, std::string{"bc"}), 2u);
+
+	counted c;
+	counted::reset();
+	vta::visit_at(1, take_by_value{}, c, counted{}, c);
+	BOOST_CHECK_EQUAL(counted::copies, 0);
+	BOOST_CHECK_EQUAL(counted::moves, 1);
+
+	std::vector<int> expected(200);
+	std::iota(expected.begin(), expected.end(), 0);
+	BOOST_CHECK(visit_every(std::make_index_sequence<200>{}) == expected);
+}
+
+BOOST_AUTO_TEST_CASE(runtime_at) {
+	int a = 1;
+	int b = 2;
+	int c = 3;
+	BOOST_CHECK_EQUAL(&vta::runtime_at(0, a, b, c), &a);
+	BOOST_CHECK_EQUAL(&vta::runtime_at(2, a, b, c), &c);
+	vta::runtime_at(1, a, b, c) = 5;
+	BOOST_CHECK_EQUAL(b, 5);
+	BOOST_CHECK_THROW(vta::runtime_at(3, a, b, c), std::out_of_range);
+
+	int const d = 4;
+	static_assert(std::is_same<decltype(vta::runtime_at(0, d, d)), int const&>::value, "");
+	static_assert(vta::runtime_at(1, 1, 2, 3) == 2, "");
+
+	// The arguments' own addresses are used even when operator& is overloaded
+	hides_address e;
+	hides_address f;
+	BOOST_CHECK(&vta::runtime_at(1, e, f).value == &f.value);
+}
+
+BOOST_AUTO_TEST_CASE(dispatch_bools) {
+	BOOST_CHECK_EQUAL(vta::dispatch_bools(flags_to_int{}), 0);
+	BOOST_CHECK_EQUAL(vta::dispatch_bools(flags_to_int{}, true), 1);
+	BOOST_CHECK_EQUAL(vta::dispatch_bools(flags_to_int{}, false, true, true), 3);
+	BOOST_CHECK_EQUAL(vta::dispatch_bools(flags_to_int{}, true, false, false), 4);
+
+	// Every combination of up to 10 flags reaches its own specialization
+	for(int mask = 0; mask < 8; ++mask) {
+		BOOST_CHECK_EQUAL(dispatch_mask(mask, std::make_index_sequence<3>{}), mask);
+	}
+	for(int mask = 0; mask < 1024; ++mask) {
+		BOOST_CHECK_EQUAL(dispatch_mask(mask, std::make_index_sequence<10>{}), mask);
+	}
+
+	// The flags are usable in constant expressions
+	auto const pick = [](auto use_first, auto) -> std::string {
+		static_assert(std::is_same<decltype(use_first), std::true_type>::value ||
+		              std::is_same<decltype(use_first), std::false_type>::value, "");
+		return use_first ? "first" : "second";
+	};
+	BOOST_CHECK_EQUAL(vta::dispatch_bools(pick, true, false), "first");
+	BOOST_CHECK_EQUAL(vta::dispatch_bools(pick, false, false), "second");
+
+	// The function is called where it is and references are returned as they are
+	counting_function f;
+	counting_function::reset();
+	BOOST_CHECK_EQUAL(vta::dispatch_bools(f, true, 0, static_cast<int*>(nullptr)), 1);
+	BOOST_CHECK_EQUAL(f.calls, 1);
+	BOOST_CHECK_EQUAL(counting_function::copies, 0);
+	BOOST_CHECK_EQUAL(counting_function::moves, 0);
+
+	int a = 1;
+	int b = 2;
+	auto const choose = [&a, &b](auto first) -> int& { return first ? a : b; };
+	vta::dispatch_bools(choose, false) = 5;
+	BOOST_CHECK_EQUAL(b, 5);
+}
+
+BOOST_AUTO_TEST_CASE(with_index) {
+	for(int i = 0; i < 10; ++i) {
+		BOOST_CHECK_EQUAL(vta::with_index<10>(i, indices_to_int{}), i);
+	}
+	BOOST_CHECK_EQUAL(vta::with_index<1>(0, indices_to_int{}), 0);
+	BOOST_CHECK_THROW(vta::with_index<10>(10, indices_to_int{}), std::out_of_range);
+	BOOST_CHECK_THROW(vta::with_index<10>(-1, indices_to_int{}), std::out_of_range);
+
+	static_assert(vta::with_index<10>(7, indices_to_int{}) == 7, "");
+	static_assert(vta::with_index<4>(3, constexpr_indices_to_int) == 3, "");
+
+	// The index is a constant expression
+	auto const array_size = [](auto i) { return std::array<int, i + 1>{}.size(); };
+	BOOST_CHECK_EQUAL(vta::with_index<8>(5, array_size), 6u);
+
+	counting_function f;
+	counting_function::reset();
+	BOOST_CHECK_EQUAL(vta::with_index<3>(2, f), 1);
+	BOOST_CHECK_EQUAL(counting_function::copies, 0);
+	BOOST_CHECK_EQUAL(counting_function::moves, 0);
+
+	int values[] = {1, 2, 3};
+	auto const element = [&values](auto i) -> int& { return values[i]; };
+	vta::with_index<3>(1, element) = 5;
+	BOOST_CHECK_EQUAL(values[1], 5);
+}
+
+BOOST_AUTO_TEST_CASE(with_indices) {
+	BOOST_CHECK_EQUAL(vta::with_indices<>(indices_to_int{}), 0);
+
+	for(int i = 0; i < 2; ++i) {
+		for(int j = 0; j < 3; ++j) {
+			for(int k = 0; k < 4; ++k) {
+				BOOST_CHECK_EQUAL((vta::with_indices<2, 3, 4>(i, j, k, indices_to_int{})), i * 100 + j * 10 + k);
+			}
+		}
+	}
+
+	BOOST_CHECK_THROW((vta::with_indices<2, 3, 4>(2, 0, 0, indices_to_int{})), std::out_of_range);
+	BOOST_CHECK_THROW((vta::with_indices<2, 3, 4>(0, 3, 0, indices_to_int{})), std::out_of_range);
+	BOOST_CHECK_THROW((vta::with_indices<2, 3, 4>(0, 0, -1, indices_to_int{})), std::out_of_range);
+	BOOST_CHECK_THROW((vta::with_indices<4>(std::size_t{1} << 32, indices_to_int{})), std::out_of_range);
+	BOOST_CHECK_THROW((vta::with_indices<4>(-(std::int64_t{1} << 32), indices_to_int{})), std::out_of_range);
+	BOOST_CHECK_THROW((vta::with_index<4>(std::uint64_t{1} << 63, indices_to_int{})), std::out_of_range);
+	BOOST_CHECK_EQUAL((vta::with_indices<2, 3>(std::uint8_t{1}, std::int64_t{2}, indices_to_int{})), 12);
+
+	static_assert(vta::with_indices<2, 3, 4>(1, 2, 3, indices_to_int{}) == 123, "");
+	static_assert(vta::with_indices<9, 1, 9>(8, 0, 4, constexpr_indices_to_int) == 804, "");
+	static_assert(vta::with_indices<8, 8, 8>(7, 6, 5, constexpr_indices_to_int) == 765, "");
+}
+
+BOOST_AUTO_TEST_CASE(to_array) {
+	int a = 1;
+	int const b = 2;
+	auto const ints = vta::to_array(a, b, 3);
+	static_assert(std::is_same<decltype(vta::to_array(a, b, 3)), std::array<int, 3>>::value, "");
+	BOOST_CHECK((ints == std::array<int, 3>{{1, 2, 3}}));
+	static_assert(vta::add_const(vta::to_array(4, 5, 6))[2] == 6, "");
+
+	// Move only types are moved into place
+	auto const pointers = vta::to_array(std::make_unique<int>(1), std::make_unique<int>(2));
+	BOOST_CHECK_EQUAL(*pointers[1], 2);
+
+	counted c;
+	counted::reset();
+	auto const counts = vta::to_array(counted{}, c, std::move(c));
+	static_cast<void>(counts);
+	BOOST_CHECK_EQUAL(counted::copies, 1);
+	BOOST_CHECK_EQUAL(counted::moves, 2);
+}
+
+BOOST_AUTO_TEST_CASE(to_span_of_refs) {
+	int a = 1;
+	int b = 2;
+	int c = 3;
+	for(int& x : vta::to_span_of_refs(a, b, c)) {
+		x *= 10;
+	}
+	BOOST_CHECK_EQUAL(a, 10);
+	BOOST_CHECK_EQUAL(b, 20);
+	BOOST_CHECK_EQUAL(c, 30);
+
+	auto const refs = vta::to_span_of_refs(c, a);
+	BOOST_CHECK_EQUAL(&refs[0].get(), &c);
+	BOOST_CHECK_EQUAL(&refs[1].get(), &a);
+
+	int const d = 4;
+	static_assert(std::is_same<decltype(vta::to_span_of_refs(d, d)),
+	                           std::array<std::reference_wrapper<int const>, 2>>::value, "");
+}
+
+BOOST_AUTO_TEST_CASE(sort) {
+	static_assert(std::is_same<decltype(vta::sort(1, 2)), std::array<int, 2>>::value, "");
+	static_assert(vta::add_const(vta::sort(5, 3, 9, 1, 7))[0] == 1, "");
+	static_assert(vta::add_const(vta::sort(5, 3, 9, 1, 7))[4] == 9, "");
+	BOOST_CHECK((vta::sort(3) == std::array<int, 1>{{3}}));
+	BOOST_CHECK((vta::sort(2.5, -1.0, 2.5, 0.0) == std::array<double, 4>{{-1.0, 0.0, 2.5, 2.5}}));
+
+	// A NaN is unordered but the result is still a permutation of the arguments
+	double const nan = std::numeric_limits<double>::quiet_NaN();
+	auto const with_nan = vta::sort(1.0, nan, 0.0);
+	BOOST_CHECK_EQUAL(std::count_if(with_nan.begin(), with_nan.end(), [](double x) { return std::isnan(x); }), 1);
+	BOOST_CHECK_EQUAL(std::count(with_nan.begin(), with_nan.end(), 0.0), 1);
+	BOOST_CHECK_EQUAL(std::count(with_nan.begin(), with_nan.end(), 1.0), 1);
+
+	std::string const b = "b";
+	auto const strings = vta::sort(std::string("c"), b, std::string("a"));
+	BOOST_CHECK((strings == std::array<std::string, 3>{{"a", "b", "c"}}));
+
+	BOOST_CHECK(sorts_zeros_and_ones(std::make_index_sequence<1>{}));
+	BOOST_CHECK(sorts_zeros_and_ones(std::make_index_sequence<2>{}));
+	BOOST_CHECK(sorts_zeros_and_ones(std::make_index_sequence<3>{}));
+	BOOST_CHECK(sorts_zeros_and_ones(std::make_index_sequence<4>{}));
+	BOOST_CHECK(sorts_zeros_and_ones(std::make_index_sequence<5>{}));
+	BOOST_CHECK(sorts_zeros_and_ones(std::make_index_sequence<6>{}));
+	BOOST_CHECK(sorts_zeros_and_ones(std::make_index_sequence<7>{}));
+	BOOST_CHECK(sorts_zeros_and_ones(std::make_index_sequence<8>{}));
+	BOOST_CHECK(sorts_zeros_and_ones(std::make_index_sequence<9>{}));
+	BOOST_CHECK(sorts_zeros_and_ones(std::make_index_sequence<12>{}));
+	BOOST_CHECK(sorts_random_values(std::make_index_sequence<16>{}));
+	BOOST_CHECK(sorts_random_values(std::make_index_sequence<33>{}));
+}
+
+BOOST_AUTO_TEST_CASE(nth_median) {
+	static_assert(vta::nth<0>(5, 3, 9, 1, 7) == 1, "");
+	static_assert(vta::nth<3>(5, 3, 9, 1, 7) == 7, "");
+	static_assert(vta::median(5, 3, 9, 1, 7) == 5, "");
+	static_assert(vta::median(4) == 4, "");
+
+	// The lower of the middle two
+	static_assert(vta::median(4, 1, 3, 2) == 2, "");
+	BOOST_CHECK_EQUAL(vta::median(std::string("b"), std::string("c"), std::string("a")), "b");
+}
+
+BOOST_AUTO_TEST_CASE(minmax) {
+	static_assert(vta::minmax(4).first == 4 && vta::minmax(4).second == 4, "");
+	static_assert(vta::minmax(5, 3).first == 3 && vta::minmax(5, 3).second == 5, "");
+	static_assert(vta::minmax(5, 3, 9, 1, 7).first == 1, "");
+	static_assert(vta::minmax(5, 3, 9, 1, 7).second == 9, "");
+	static_assert(vta::minmax(5, 3, 9, 1, 7, 0).first == 0, "");
+	static_assert(vta::minmax(5, 3, 9, 1, 7, 10).second == 10, "");
+	static_assert(std::is_same<decltype(vta::minmax(1, 2)), std::pair<int, int>>::value, "");
+
+	std::string const b = "b";
+	auto const strings = vta::minmax(b, std::string("c"), std::string("a"));
+	BOOST_CHECK_EQUAL(strings.first, "a");
+	BOOST_CHECK_EQUAL(strings.second, "c");
+
+	// The first of the smallest and the last of the largest, as with std::minmax
+	keyed const k[] = {{1, 0}, {0, 1}, {1, 2}, {0, 3}, {1, 4}};
+	BOOST_CHECK_EQUAL(vta::minmax(k[0], k[1], k[2], k[3], k[4]).first.id, 1);
+	BOOST_CHECK_EQUAL(vta::minmax(k[0], k[1], k[2], k[3], k[4]).second.id, 4);
+	BOOST_CHECK_EQUAL(vta::minmax(k[0], k[1], k[2], k[3]).first.id, 1);
+	BOOST_CHECK_EQUAL(vta::minmax(k[0], k[1], k[2], k[3]).second.id, 2);
+
+	// Every order of four distinct values
+	std::array<int, 4> values{{0, 1, 2, 3}};
+	do {
+		auto const result = vta::minmax(values[0], values[1], values[2], values[3]);
+		BOOST_CHECK_EQUAL(result.first, 0);
+		BOOST_CHECK_EQUAL(result.second, 3);
+	} while(std::next_permutation(values.begin(), values.end()));
+}
+
+BOOST_AUTO_TEST_CASE(sorted) {
+	std::stringstream ss;
+	vta::sorted(vta::map(printer{ss}))(3, 1, 2);
+	BOOST_CHECK_EQUAL(ss.str(), "123");
+
+	BOOST_CHECK_EQUAL(vta::sorted(constexpr_subtract)(1, 10), -9);
+	static_assert(vta::sorted(constexpr_subtract)(10, 1) == -9, "");
+
+	// The sorted values are passed as rvalues
+	std::string const a = "a";
+	auto const concatenate = [](std::string&& x, std::string&& y) { return x + y; };
+	BOOST_CHECK_EQUAL(vta::sorted(concatenate)(std::string("b"), a), "ab");
 }
 
 BOOST_AUTO_TEST_CASE(head_t) {
@@ -145,6 +860,8 @@ BOOST_AUTO_TEST_CASE(head_t) {
 	static_assert(std::is_same<int, vta::head_t<int, char>>::value, "");
 	static_assert(std::is_same<float, vta::head_t<float, char>>::value, "");
 	static_assert(!std::is_same<float, vta::head_t<int, char>>::value, "");
+	static_assert(std::is_same<int&, vta::head_t<int&, char>>::value, "");
+	static_assert(std::is_same<int&&, vta::head_t<int&&, char>>::value, "");
 }
 
 BOOST_AUTO_TEST_CASE(last_t) {
@@ -152,6 +869,7 @@ BOOST_AUTO_TEST_CASE(last_t) {
 	static_assert(std::is_same<char, vta::last_t<int, char>>::value, "");
 	static_assert(std::is_same<char, vta::last_t<float, char>>::value, "");
 	static_assert(!std::is_same<int, vta::last_t<int, char>>::value, "");
+	static_assert(std::is_same<char const&, vta::last_t<int, char const&>>::value, "");
 }
 
 BOOST_AUTO_TEST_CASE(at_t) {
@@ -161,6 +879,94 @@ BOOST_AUTO_TEST_CASE(at_t) {
 	static_assert(std::is_same<char, vta::at_t<-1>::type<int, char>>::value, "");
 	static_assert(std::is_same<int, vta::at_t<2>::type<float, char, int>>::value, "");
 	static_assert(!std::is_same<int, vta::at_t<-2>::type<float, char, int>>::value, "");
+	static_assert(std::is_same<char&, vta::at_t<1>::type<float, char&, int>>::value, "");
+	static_assert(std::is_same<char const(&)[4], vta::at_t<0>::type<char const(&)[4]>>::value, "");
+}
+
+BOOST_AUTO_TEST_CASE(reference_preserving_access) {
+	counted c;
+	counted::reset();
+
+	static_assert(std::is_same<decltype(vta::head(c, 1)), counted&>::value, "");
+	static_assert(std::is_same<decltype(vta::head(std::move(c), 1)), counted>::value, "");
+	static_assert(std::is_same<decltype(vta::last(1, c)), counted&>::value, "");
+	static_assert(std::is_same<decltype(vta::at<1>(1, c, 2)), counted&>::value, "");
+	static_assert(std::is_same<decltype(vta::at<-2>(1, std::move(c), 2)), counted>::value, "");
+	static_assert(std::is_same<decltype(vta::last(1, counted{})), counted>::value, "");
+
+	BOOST_CHECK_EQUAL(&vta::head(c, 1), &c);
+	BOOST_CHECK_EQUAL(&vta::last(1, '2', c), &c);
+	BOOST_CHECK_EQUAL(&vta::at<1>(1, c, '2'), &c);
+	BOOST_CHECK_EQUAL(counted::copies, 0);
+	BOOST_CHECK_EQUAL(counted::moves, 0);
+
+	counted const moved = vta::at<1>(1, std::move(c), '2');
+	BOOST_CHECK_NE(&moved, &c);
+	BOOST_CHECK_EQUAL(counted::copies, 0);
+	BOOST_CHECK_EQUAL(counted::moves, 1);
+
+	// A temporary is returned by value, so binding it to a reference extends its lifetime
+	std::string const& s = vta::head(std::string(40, 'x'), 1);
+	BOOST_CHECK_EQUAL(s, std::string(40, 'x'));
+}
+
+BOOST_AUTO_TEST_CASE(reference_preserving_transformations) {
+	counted a;
+	counted b;
+	counted::reset();
+
+	auto first = vta::forward_after<vta::reverse>(return_first{});
+	static_assert(std::is_same<decltype(first(a, b)), counted&>::value, "");
+	BOOST_CHECK_EQUAL(&first(a, b), &b);
+	BOOST_CHECK_EQUAL(&vta::forward_after<vta::id>(return_first{})(a, b), &a);
+	BOOST_CHECK_EQUAL(&vta::forward_after<vta::flip>(return_first{})(a, b), &b);
+	BOOST_CHECK_EQUAL((&vta::forward_after<vta::swap<0, -1>>(return_first{})(a, 1, b)), &b);
+	BOOST_CHECK_EQUAL((&vta::forward_after<vta::compose<vta::reverse, vta::drop<1>>>(return_first{})(a, b, 1)),
+	                  &b);
+	BOOST_CHECK_EQUAL((&vta::forward_after<vta::filter<is_counted>>(return_first{})(1, "a", a, b)), &a);
+	BOOST_CHECK_EQUAL(counted::copies, 0);
+	BOOST_CHECK_EQUAL(counted::moves, 0);
+
+	// Arguments taken by value are moved or copied exactly once, however deep the transformation
+	vta::forward_after<vta::compose<vta::reverse, vta::shift<1>, vta::cycle<0, 2>>>(take_by_value{})
+	  (counted{}, counted{}, counted{});
+	BOOST_CHECK_EQUAL(counted::copies, 0);
+	BOOST_CHECK_EQUAL(counted::moves, 3);
+
+	counted::reset();
+	vta::forward_after<vta::compose<vta::reverse, vta::shift<1>, vta::cycle<0, 2>>>(take_by_value{})
+	  (a, b, a);
+	BOOST_CHECK_EQUAL(counted::copies, 3);
+	BOOST_CHECK_EQUAL(counted::moves, 0);
+}
+
+BOOST_AUTO_TEST_CASE(reference_preserving_folds) {
+	counted a;
+	counted b;
+	counted c;
+	counted::reset();
+
+	static_assert(std::is_same<decltype(vta::foldl(return_first{})(a, b, c)), counted&>::value, "");
+	static_assert(std::is_same<decltype(vta::foldr(return_first{})(a, b, c)), counted&>::value, "");
+	BOOST_CHECK_EQUAL(&vta::foldl(return_first{})(a, b, c), &a);
+	BOOST_CHECK_EQUAL(&vta::foldr(return_first{})(a, b, c), &a);
+	static_assert(std::is_same<decltype(vta::fold_tree(return_first{})(a, b, c)), counted&>::value, "");
+	BOOST_CHECK_EQUAL(&vta::fold_tree(return_first{})(a, b, c), &a);
+	BOOST_CHECK_EQUAL(counted::copies, 0);
+	BOOST_CHECK_EQUAL(counted::moves, 0);
+
+	// foldl returns its result by value while foldr returns the last call's result directly, and
+	// intermediate results are passed on without being copied or moved
+	counted const left = vta::foldl(make_counted{})(a, b, c, counted{}, a);
+	BOOST_CHECK_EQUAL(counted::copies, 0);
+	BOOST_CHECK_EQUAL(counted::moves, 1);
+
+	counted::reset();
+	counted const right = vta::foldr(make_counted{})(a, b, c, counted{}, a);
+	BOOST_CHECK_EQUAL(counted::copies, 0);
+	BOOST_CHECK_EQUAL(counted::moves, 0);
+	static_cast<void>(left);
+	static_cast<void>(right);
 }
 
 /**************************************************************************************************
@@ -423,6 +1229,103 @@ BOOST_AUTO_TEST_CASE(take) {
 	}
 }
 
+BOOST_AUTO_TEST_CASE(slice) {
+	{
+		std::stringstream ss;
+		vta::forward_after<vta::slice<0, 0>>(vta::map(printer{ss}))(1, '2', 3u, 4.5, "six");
+		BOOST_CHECK_EQUAL(ss.str(), "1");
+	}
+
+	{
+		std::stringstream ss;
+		vta::forward_after<vta::slice<1, 2>>(vta::map(printer{ss}))(1, '2', 3u, 4.5, "six");
+		BOOST_CHECK_EQUAL(ss.str(), "23");
+	}
+
+	{
+		std::stringstream ss;
+		vta::forward_after<vta::slice<0, -2>>(vta::map(printer{ss}))(1, '2', 3u, 4.5, "six");
+		BOOST_CHECK_EQUAL(ss.str(), "1234.5");
+	}
+
+	{
+		std::stringstream ss;
+		vta::forward_after<vta::slice<-2, -1>>(vta::map(printer{ss}))(1, '2', 3u, 4.5, "six");
+		BOOST_CHECK_EQUAL(ss.str(), "4.5six");
+	}
+
+	{
+		auto const sliced = transformed_sequence<vta::slice<10, -11>>(std::make_index_sequence<128>{});
+		std::vector<int> expected(108);
+		std::iota(expected.begin(), expected.end(), 10);
+		BOOST_CHECK(sliced == expected);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(permute) {
+	{
+		std::stringstream ss;
+		vta::forward_after<vta::permute<>>(vta::map(printer{ss}))(1, '2', 3u, 4.5, "six");
+		BOOST_CHECK_EQUAL(ss.str(), "");
+	}
+
+	{
+		std::stringstream ss;
+		vta::forward_after<vta::permute<0, 1, 2, 3, 4>>(vta::map(printer{ss}))(1, '2', 3u, 4.5, "six");
+		BOOST_CHECK_EQUAL(ss.str(), "1234.5six");
+	}
+
+	{
+		std::stringstream ss;
+		vta::forward_after<vta::permute<4, 2, 0, 1, 3>>(vta::map(printer{ss}))(1, '2', 3u, 4.5, "six");
+		BOOST_CHECK_EQUAL(ss.str(), "six3124.5");
+	}
+
+	{
+		std::stringstream ss;
+		vta::forward_after<vta::permute<-1, 0, -2>>(vta::map(printer{ss}))(1, '2', 3u, 4.5, "six");
+		BOOST_CHECK_EQUAL(ss.str(), "six14.5");
+	}
+
+	{
+		auto const digits = [](std::unique_ptr<int> a, std::unique_ptr<int> b) { return *a * 10 + *b; };
+		auto const result = vta::forward_after<vta::permute<2, 0>>(digits)(std::make_unique<int>(1),
+		                                                                   std::make_unique<int>(2),
+		                                                                   std::make_unique<int>(3));
+		BOOST_CHECK_EQUAL(result, 31);
+	}
+
+	static_assert(vta::add_const(vta::forward_after<vta::permute<1, 0>>(subtract{}))(1, 3) == 2, "");
+}
+
+BOOST_AUTO_TEST_CASE(large_positional) {
+	typedef std::make_index_sequence<200> sequence;
+	std::vector<int> expected(200);
+
+	std::iota(expected.begin(), expected.end(), 0);
+	std::rotate(expected.begin(), expected.begin() + 150, expected.end());
+	BOOST_CHECK((transformed_sequence<vta::shift<150>>(sequence{}) == expected));
+
+	std::iota(expected.begin(), expected.end(), 0);
+	std::rotate(expected.begin() + 1, expected.begin() + 51, expected.end());
+	BOOST_CHECK(transformed_sequence<vta::shift_tail<50>>(sequence{}) == expected);
+
+	std::iota(expected.begin(), expected.end(), 0);
+	std::swap(expected[3], expected[190]);
+	BOOST_CHECK((transformed_sequence<vta::swap<3, -10>>(sequence{}) == expected));
+
+	std::iota(expected.begin(), expected.end(), 0);
+	std::swap(expected[0], expected[100]);
+	std::swap(expected[0], expected[199]);
+	BOOST_CHECK((transformed_sequence<vta::cycle<0, 100, 199>>(sequence{}) == expected));
+
+	std::iota(expected.begin(), expected.end(), 0);
+	BOOST_CHECK(transformed_sequence<vta::take<150>>(sequence{})
+	              == std::vector<int>(expected.begin(), expected.begin() + 150));
+	BOOST_CHECK(transformed_sequence<vta::drop<150>>(sequence{})
+	              == std::vector<int>(expected.begin() + 150, expected.end()));
+}
+
 BOOST_AUTO_TEST_CASE(cycle) {
 	{
 		std::stringstream ss;
@@ -503,6 +1406,20 @@ BOOST_AUTO_TEST_CASE(reverse) {
 		vta::forward_after<vta::reverse>(vta::map(printer{ss}))(1, '2', 3u, 4.5, "six");
 		BOOST_CHECK_EQUAL(ss.str(), "six4.5321");
 	}
+
+	{
+		auto const reversed = transformed_sequence<vta::reverse>(std::make_index_sequence<256>{});
+		std::vector<int> expected(256);
+		std::iota(expected.rbegin(), expected.rend(), 0);
+		BOOST_CHECK(reversed == expected);
+	}
+
+	{
+		auto const digits = [](std::unique_ptr<int> a, std::unique_ptr<int> b) { return *a * 10 + *b; };
+		auto const result = vta::forward_after<vta::reverse>(digits)(std::make_unique<int>(1),
+		                                                             std::make_unique<int>(2));
+		BOOST_CHECK_EQUAL(result, 21);
+	}
 }
 
 BOOST_AUTO_TEST_CASE(filter) {
@@ -535,6 +1452,63 @@ BOOST_AUTO_TEST_CASE(filter) {
 		vta::forward_after<vta::filter<std::is_integral>>(vta::map(printer{ss}))(1, '2', 3u, 4.5, "six");
 		BOOST_CHECK_EQUAL(ss.str(), "123");
 	}
+
+	static_assert(vta::filter<std::is_integral>::positions<>::size == 0, "");
+	static_assert(vta::filter<std::is_integral>::positions<double, char const*>::size == 0, "");
+	typedef vta::filter<std::is_integral>::positions<double, int, char const*, char, long> mixed;
+	static_assert(mixed::size == 3, "");
+	static_assert(mixed::at(0) == 1 && mixed::at(1) == 3 && mixed::at(2) == 4, "");
+
+	// Arguments are forwarded straight to the function. The predicate sees the deduced type, which
+	// is an lvalue reference for lvalues.
+	int i = 1;
+	long l = 2;
+	BOOST_CHECK_EQUAL((&vta::forward_after<vta::filter<is_int>>(return_first{})(2.5, l, "3", i)), &i);
+	BOOST_CHECK_EQUAL((vta::forward_after<vta::filter<std::is_integral>>(return_first{})(2.5, "3", 4)), 4);
+	static_assert(vta::add_const(vta::forward_after<vta::filter<std::is_integral>>(subtract{}))(5, 2.5, 3) == 2, "");
+}
+
+BOOST_AUTO_TEST_CASE(large_filter) {
+	typedef std::make_index_sequence<300> sequence;
+	BOOST_CHECK(filtered_ints<1>(sequence{}) == multiples_below<1>(300));
+	BOOST_CHECK(filtered_ints<2>(sequence{}) == multiples_below<2>(300));
+	BOOST_CHECK(filtered_ints<7>(sequence{}) == multiples_below<7>(300));
+	BOOST_CHECK(filtered_ints<299>(sequence{}) == multiples_below<299>(300));
+	BOOST_CHECK(filtered_ints<300>(sequence{}) == std::vector<int>{0});
+}
+
+BOOST_AUTO_TEST_CASE(sort_by) {
+	{
+		std::stringstream ss;
+		vta::forward_after<vta::sort_by<size_key>>(vta::map(printer{ss}))(1.5, 'a', 2, 'b', short{3}, 4);
+		BOOST_CHECK_EQUAL(ss.str(), "ab3241.5");
+	}
+
+	{
+		std::stringstream ss;
+		vta::forward_after<vta::sort_by<size_key>>(vta::map(printer{ss}))();
+		vta::forward_after<vta::sort_by<size_key>>(vta::map(printer{ss}))(1);
+		BOOST_CHECK_EQUAL(ss.str(), "1");
+	}
+
+	typedef vta::sort_by<size_key>::positions<double, char, int, char> positions;
+	static_assert(positions::size == 4, "");
+	static_assert(positions::at(0) == 1 && positions::at(1) == 3, "");
+	static_assert(positions::at(2) == 2 && positions::at(3) == 0, "");
+
+	// Large packs, where sorting by I % 3 also checks that equal keys keep their order
+	typedef std::make_index_sequence<300> sequence;
+	std::vector<std::size_t> reversed(300);
+	std::iota(reversed.rbegin(), reversed.rend(), std::size_t{0});
+	BOOST_CHECK(sorted_tags<descending_tag>(sequence{}) == reversed);
+
+	std::vector<std::size_t> by_remainder;
+	for(std::size_t r = 0; r < 3; ++r) {
+		for(std::size_t i = r; i < 300; i += 3) {
+			by_remainder.push_back(i);
+		}
+	}
+	BOOST_CHECK(sorted_tags<remainder_of_3>(sequence{}) == by_remainder);
 }
 
 // Functions
@@ -545,6 +1519,30 @@ BOOST_AUTO_TEST_CASE(map) {
 	BOOST_CHECK_EQUAL(ss.str(), "123 4.5 hello world!");
 }
 
+BOOST_AUTO_TEST_CASE(map_tuple) {
+	{
+		std::stringstream ss;
+		vta::map(printer{ss}, std::make_tuple(1, '2', " three"));
+		BOOST_CHECK_EQUAL(ss.str(), "12 three");
+	}
+
+	{
+		std::vector<int> ints;
+		vta::map(collector{ints}, std::array<int, 3>{{4, 5, 6}});
+		vta::map(collector{ints}, std::make_pair(7, 8));
+		vta::map(collector{ints}, std::tuple<>{});
+		BOOST_CHECK((ints == std::vector<int>{4, 5, 6, 7, 8}));
+	}
+
+	// The function is called directly, so even an lvalue is not copied
+	counting_function f;
+	counting_function::reset();
+	vta::map(f, std::make_tuple(1, 2.5, 'c'));
+	BOOST_CHECK_EQUAL(f.calls, 3);
+	BOOST_CHECK_EQUAL(counting_function::copies, 0);
+	BOOST_CHECK_EQUAL(counting_function::moves, 0);
+}
+
 BOOST_AUTO_TEST_CASE(adjacent_map) {
 	std::string s;
 	adjacent_printer printer{s};
@@ -552,10 +1550,124 @@ BOOST_AUTO_TEST_CASE(adjacent_map) {
 	BOOST_CHECK_EQUAL(s, "26122030");
 }
 
+BOOST_AUTO_TEST_CASE(adjacent_map_windows) {
+	{
+		std::stringstream ss;
+		vta::adjacent_map<1>(printer{ss})(1, '2', "3");
+		BOOST_CHECK_EQUAL(ss.str(), "123");
+	}
+
+	{
+		std::stringstream ss;
+		vta::adjacent_map<3>(vta::map(printer{ss}))(1, '2', "3", 4.5);
+		BOOST_CHECK_EQUAL(ss.str(), "123234.5");
+	}
+
+	// Packs shorter than the window are not visited
+	{
+		std::stringstream ss;
+		vta::adjacent_map<3>(vta::map(printer{ss}))(1, 2);
+		vta::adjacent_map<3>(vta::map(printer{ss}))();
+		BOOST_CHECK_EQUAL(ss.str(), "");
+	}
+
+	BOOST_CHECK(window_sums<2>(std::make_index_sequence<300>{}) == expected_window_sums(2, 300));
+	BOOST_CHECK(window_sums<150>(std::make_index_sequence<300>{}) == expected_window_sums(150, 300));
+	BOOST_CHECK(window_sums<300>(std::make_index_sequence<300>{}) == expected_window_sums(300, 300));
+
+	// Each argument is forwarded in the window it starts, which is the last that includes it, and
+	// passed as an lvalue to the windows before
+	counted a;
+	counted::reset();
+	vta::adjacent_map<2>(take_by_value{})(counted{}, counted{}, a, counted{});
+	BOOST_CHECK_EQUAL(counted::moves, 2);
+	BOOST_CHECK_EQUAL(counted::copies, 4);
+
+	counted::reset();
+	vta::adjacent_map<3>([](auto&&...) {})(counted{}, a, counted{}, counted{}, a);
+	BOOST_CHECK_EQUAL(counted::moves, 0);
+	BOOST_CHECK_EQUAL(counted::copies, 0);
+}
+
 BOOST_AUTO_TEST_CASE(foldl) {
 	auto s = string_concat{};
 	auto const result = vta::foldl(s)(1, 2, 3);
 	BOOST_CHECK_EQUAL(result, "123");
+	BOOST_CHECK_EQUAL(vta::foldl(bracket{})(1, 2, 3, 4), "(((12)3)4)");
+
+	static_assert(vta::add_const(vta::foldl(subtract{}))(1, 2, 3) == -4, "");
+	static_assert(left_difference(std::make_index_sequence<300>{}) == -299 * 300 / 2, "");
+}
+
+BOOST_AUTO_TEST_CASE(foldl_tuple) {
+	BOOST_CHECK_EQUAL(vta::foldl(bracket{}, std::make_tuple(1, '2', "3", 4.5)), "(((12)3)4.5)");
+	BOOST_CHECK_EQUAL(vta::foldl(bracket{}, std::make_pair(1, 2)), "(12)");
+	static_assert(vta::foldl(subtract{}, std::array<int, 3>{{10, 1, 2}}) == 7, "");
+
+	// The elements of an rvalue tuple are forwarded, so only the result is moved, as with arguments
+	std::tuple<counted, counted, counted> values;
+	counted::reset();
+	counted const result = vta::foldl(make_counted{}, std::move(values));
+	static_cast<void>(result);
+	BOOST_CHECK_EQUAL(counted::copies, 0);
+	BOOST_CHECK_EQUAL(counted::moves, 1);
+}
+
+BOOST_AUTO_TEST_CASE(foldl_into) {
+	std::string str = ">";
+	auto const append = [](std::string& acc, auto const& x) { acc += x; };
+	std::string const name = "World";
+	std::string& result = vta::foldl_into(str, append)("Hello ", name, '!');
+	BOOST_CHECK_EQUAL(&result, &str);
+	BOOST_CHECK_EQUAL(str, ">Hello World!");
+	BOOST_CHECK_EQUAL(&vta::foldl_into(str, append)(), &str);
+
+	// The accumulator is updated in place, so it is never copied or moved
+	counted acc;
+	counted::reset();
+	std::vector<int> seen;
+	vta::foldl_into(acc, [&seen](counted&, int x) { seen.push_back(x); })(1, 2, 3);
+	BOOST_CHECK_EQUAL(counted::copies, 0);
+	BOOST_CHECK_EQUAL(counted::moves, 0);
+	BOOST_CHECK((seen == std::vector<int>{1, 2, 3}));
+
+	// Arguments are forwarded
+	std::vector<std::unique_ptr<int>> owners;
+	auto const take = [](std::vector<std::unique_ptr<int>>& acc, std::unique_ptr<int> p) {
+		acc.push_back(std::move(p));
+	};
+	vta::foldl_into(owners, take)(std::make_unique<int>(1), std::make_unique<int>(2));
+	BOOST_CHECK_EQUAL(owners.size(), 2);
+	BOOST_CHECK_EQUAL(*owners[1], 2);
+
+	static_assert(sum_into(std::make_index_sequence<300>{}) == 299 * 300 / 2, "");
+}
+
+BOOST_AUTO_TEST_CASE(fanout) {
+	constexpr auto results = vta::fanout(add{}, minimum{}, maximum{})(3, 1, 4, 1, 5);
+	static_assert(std::get<0>(results) == 14, "");
+	static_assert(std::get<1>(results) == 1, "");
+	static_assert(std::get<2>(results) == 5, "");
+
+	BOOST_CHECK((vta::fanout(add{}, bracket{})(7) == std::make_tuple(7, 7)));
+	BOOST_CHECK((vta::fanout(bracket{}, string_concat{})(1, 2, 3) == std::make_tuple("((12)3)", "123")));
+	BOOST_CHECK((vta::fanout()(1, 2) == std::tuple<>{}));
+
+	// Each fold accumulates into the type that foldl would return
+	auto const sum = [](auto l, auto r) { return l + r; };
+	static_assert(std::is_same<decltype(vta::fanout(sum)(1, 2.5, 3)), std::tuple<double>>::value, "");
+	BOOST_CHECK_EQUAL(std::get<0>(vta::fanout(sum)(1, 2.5, 3)), 6.5);
+
+	// The type is worked out from the lvalue arguments and rvalue accumulator that f is called with
+	static_assert(std::is_same<decltype(vta::fanout(lvalue_sum{})(1, 2)), std::tuple<int>>::value, "");
+	BOOST_CHECK((vta::fanout(lvalue_sum{})(1, 2, 3) == std::make_tuple(6)));
+
+	// Every fold sees an argument before any fold sees the next
+	std::vector<int> calls;
+	auto const first = [&calls](int acc, int x) { calls.push_back(10 + x); return acc + x; };
+	auto const second = [&calls](int acc, int x) { calls.push_back(20 + x); return acc * x; };
+	BOOST_CHECK((vta::fanout(first, second)(1, 2, 3) == std::make_tuple(6, 6)));
+	BOOST_CHECK((calls == std::vector<int>{12, 22, 13, 23}));
 }
 
 BOOST_AUTO_TEST_CASE(foldr) {
@@ -563,6 +1675,22 @@ BOOST_AUTO_TEST_CASE(foldr) {
 	BOOST_CHECK_EQUAL(vta::foldr(minus)(1), 1);
 	BOOST_CHECK_EQUAL(vta::foldr(minus)(1, 2), -1);
 	BOOST_CHECK_EQUAL(vta::foldr(minus)(1, 2, 3), 2);
+	BOOST_CHECK_EQUAL(vta::foldr(bracket{})(1, 2, 3, 4), "(1(2(34)))");
+
+	static_assert(vta::add_const(vta::foldr(subtract{}))(1) == 1, "");
+	static_assert(vta::add_const(vta::foldr(subtract{}))(1, 2, 3) == 2, "");
+	static_assert(right_difference(std::make_index_sequence<300>{}) == -150, "");
+}
+
+BOOST_AUTO_TEST_CASE(fold_tree) {
+	BOOST_CHECK_EQUAL(vta::fold_tree(string_concat{})(1), 1);
+	BOOST_CHECK_EQUAL(vta::fold_tree(string_concat{})(1, 2, 3, 4, 5), "12345");
+	BOOST_CHECK_EQUAL(vta::fold_tree(bracket{})(1, 2), "(12)");
+	BOOST_CHECK_EQUAL(vta::fold_tree(bracket{})(1, 2, 3), "(1(23))");
+	BOOST_CHECK_EQUAL(vta::fold_tree(bracket{})(1, 2, 3, 4, 5), "((12)(3(45)))");
+
+	static_assert(vta::add_const(vta::fold_tree(add{}))(1, 2, 3, 4, 5, 6, 7, 8) == 36, "");
+	static_assert(tree_sum(std::make_index_sequence<200>{}) == 199 * 200 / 2, "");
 }
 
 BOOST_AUTO_TEST_CASE(compose) {
@@ -577,6 +1705,152 @@ BOOST_AUTO_TEST_CASE(compose) {
 		vta::forward_after<vta::compose<vta::left_shift<1>, vta::flip>>(vta::map(printer{ss}))(0, 1, 2, 3, 4);
 		BOOST_CHECK_EQUAL(ss.str(), "21340");
 	}
+
+	{
+		std::stringstream ss;
+		vta::forward_after<vta::compose<>>(vta::map(printer{ss}))(0, 1, 2, 3, 4);
+		BOOST_CHECK_EQUAL(ss.str(), "01234");
+	}
+
+	{
+		std::stringstream ss;
+		vta::forward_after<vta::compose<vta::filter<std::is_integral>, vta::reverse, vta::drop<1>>>(
+		  vta::map(printer{ss}))(0, 1.5, 2, "3", 4, 5u);
+		BOOST_CHECK_EQUAL(ss.str(), "420");
+	}
+}
+
+BOOST_AUTO_TEST_CASE(apply_after) {
+	{
+		std::stringstream ss;
+		vta::apply_after<vta::reverse>(vta::map(printer{ss}), std::make_tuple(1, '2', " three"));
+		BOOST_CHECK_EQUAL(ss.str(), " three21");
+	}
+
+	{
+		std::vector<int> ints;
+		vta::apply_after<vta::filter<is_int>>(vta::map(collector{ints}), std::make_tuple(1, 2.5, 3, "4", 5));
+		BOOST_CHECK((ints == std::vector<int>{1, 3, 5}));
+	}
+
+	static_assert(vta::apply_after<vta::flip>(subtract{}, std::make_pair(1, 3)) == 2, "");
+	static_assert(vta::apply_after<vta::id>(subtract{}, std::array<int, 2>{{1, 3}}) == -2, "");
+	static_assert(vta::apply_after<vta::take<2>>(subtract{}, std::make_tuple(1, 3, 5)) == -2, "");
+}
+
+// Elements are forwarded according to the value category of the tuple, without being copied
+BOOST_AUTO_TEST_CASE(apply_after_references) {
+	counted a;
+	std::tuple<int, counted, counted&> values{1, counted{}, a};
+	counted::reset();
+
+	BOOST_CHECK_EQUAL(&vta::apply_after<vta::id>(return_first{}, values), &std::get<0>(values));
+	BOOST_CHECK_EQUAL(&vta::apply_after<vta::drop<1>>(return_first{}, values), &std::get<1>(values));
+	BOOST_CHECK_EQUAL(&vta::apply_after<vta::drop<2>>(return_first{}, std::move(values)), &a);
+	static_assert(std::is_same<decltype(vta::apply_after<vta::id>(return_first{}, values)), int&>::value, "");
+	static_assert(std::is_same<decltype(vta::apply_after<vta::id>(return_first{}, std::move(values))), int&&>::value,
+	              "");
+	static_assert(std::is_same<decltype(vta::apply_after<vta::drop<2>>(return_first{}, std::move(values))),
+	                           counted&>::value, "");
+	BOOST_CHECK_EQUAL(counted::copies, 0);
+	BOOST_CHECK_EQUAL(counted::moves, 0);
+
+	std::tuple<counted, counted, counted> owned;
+	counted::reset();
+	vta::apply_after<vta::compose<vta::reverse, vta::shift<1>>>(take_by_value{}, owned);
+	BOOST_CHECK_EQUAL(counted::copies, 3);
+	BOOST_CHECK_EQUAL(counted::moves, 0);
+
+	counted::reset();
+	vta::apply_after<vta::compose<vta::reverse, vta::shift<1>>>(take_by_value{}, std::move(owned));
+	BOOST_CHECK_EQUAL(counted::copies, 0);
+	BOOST_CHECK_EQUAL(counted::moves, 3);
+}
+
+// A chain of positional transformations forwards the same arguments as applying them one at a time
+BOOST_AUTO_TEST_CASE(compose_positions) {
+	typedef vta::compose<vta::reverse, vta::shift<2>, vta::swap<0, -1>> chain;
+	static_assert(std::is_base_of<vta::detail::positional_tag, chain>::value, "");
+	static_assert(std::is_base_of<vta::detail::positional_tag, vta::compose<vta::reverse, vta::flip, vta::id>>::value,
+	  "");
+	static_assert(!std::is_base_of<vta::detail::positional_tag, vta::compose<vta::reverse, vta::call_if<true>>>::value,
+	  "");
+
+	typedef chain::positions<int, int, int, int, int> positions;
+	static_assert(positions::size == 5, "");
+	static_assert(positions::at(0) == 3 && positions::at(1) == 1 && positions::at(2) == 0, "");
+	static_assert(positions::at(3) == 4 && positions::at(4) == 2, "");
+
+	typedef std::make_index_sequence<200> sequence;
+	BOOST_CHECK((transformed_sequence<chain>(sequence{}) ==
+	             transformed_sequence<vta::detail::nested_compose<vta::reverse, vta::shift<2>, vta::swap<0, -1>>>(
+	               sequence{})));
+
+	typedef vta::compose<vta::drop<10>, vta::cycle<0, 50, 99>, vta::reverse, vta::take<150>, vta::shift_tail<7>>
+	  long_chain;
+	BOOST_CHECK((transformed_sequence<long_chain>(sequence{}) ==
+	             transformed_sequence<vta::detail::nested_compose<vta::drop<10>, vta::cycle<0, 50, 99>, vta::reverse,
+	                                                              vta::take<150>, vta::shift_tail<7>>>(sequence{})));
+
+	// Nested compositions are flattened into the same positions
+	typedef vta::compose<vta::compose<vta::drop<10>, vta::cycle<0, 50, 99>>,
+	                     vta::compose<vta::reverse, vta::take<150>>, vta::shift_tail<7>>
+	  nested_chain;
+	BOOST_CHECK(transformed_sequence<nested_chain>(sequence{}) == transformed_sequence<long_chain>(sequence{}));
+
+	// flip and id fuse with the rest of a chain
+	typedef vta::compose<chain, vta::flip, vta::id, vta::reverse> flip_chain;
+	static_assert(std::is_base_of<vta::detail::positional_tag, flip_chain>::value, "");
+	static_assert(flip_chain::positions<int, int, int, int, int>::at(0) == 2, "");
+	BOOST_CHECK((transformed_sequence<flip_chain>(std::make_index_sequence<5>{}) == std::vector<int>{2, 4, 0, 3, 1}));
+	BOOST_CHECK((transformed_sequence<flip_chain>(sequence{}) ==
+	             transformed_sequence<vta::detail::nested_compose<chain, vta::flip, vta::id, vta::reverse>>(
+	               sequence{})));
+
+	// A positional chain around a transformation that is not positional falls back to applying the
+	// stages one at a time
+	BOOST_CHECK((transformed_sequence<vta::compose<chain, vta::call_if<true>, vta::flip>>(
+	               std::make_index_sequence<5>{}) == std::vector<int>{1, 3, 0, 4, 2}));
+}
+
+// Calling through a transformation, however deeply composed, never copies or moves the function
+BOOST_AUTO_TEST_CASE(functor_copies) {
+	counting_function f;
+	counting_function::reset();
+
+	vta::forward_after<vta::compose<vta::reverse, vta::flip, vta::shift<1>>>(vta::by_ref(f))(1, 2, 3);
+	vta::forward_after<vta::compose<vta::compose<vta::flip, vta::id>, vta::call_if<true>, vta::flip>>(
+	  vta::by_ref(f))(1, 2, 3);
+	vta::forward_after<vta::compose<vta::reverse, vta::shift<1>, vta::drop<1>>>(vta::by_ref(f))(1, 2, 3);
+	BOOST_CHECK_EQUAL(f.calls, 3);
+	BOOST_CHECK_EQUAL(counting_function::copies, 0);
+	BOOST_CHECK_EQUAL(counting_function::moves, 0);
+
+	// A function passed as an rvalue is moved when the functor is made, but not when it is called
+	auto nested = vta::forward_after<vta::compose<vta::flip, vta::reverse, vta::flip>>(counting_function{});
+	BOOST_CHECK_EQUAL(counting_function::copies, 0);
+	counting_function::reset();
+	nested(1, 2, 3);
+	nested(1, 2, 3);
+	BOOST_CHECK_EQUAL(counting_function::copies, 0);
+	BOOST_CHECK_EQUAL(counting_function::moves, 0);
+
+	// An lvalue function is copied once, when the functor is made, unless it is passed through by_ref
+	vta::map(f)(1, 2, 3);
+	vta::forward_after<vta::compose<vta::flip, vta::reverse>>(f)(1, 2, 3);
+	BOOST_CHECK_EQUAL(counting_function::copies, 2);
+	BOOST_CHECK_EQUAL(f.calls, 3);
+
+	counting_function::reset();
+	vta::map(vta::by_ref(f))(1, 2, 3);
+	vta::adjacent_map<2>(vta::by_ref(f))(1, 2, 3);
+	BOOST_CHECK_EQUAL(vta::foldl(vta::by_ref(f))(1, 2, 3), 10);
+	vta::forward_after<vta::compose<vta::flip, vta::reverse>>(vta::map(vta::by_ref(f)))(1, 2, 3);
+	BOOST_CHECK_EQUAL(f.calls, 13);
+	BOOST_CHECK_EQUAL(counting_function::copies, 0);
+	BOOST_CHECK_EQUAL(counting_function::moves, 0);
+
+	static_assert(vta::add_const(vta::foldl(vta::by_ref(constexpr_subtract)))(10, 1, 2) == 7, "");
 }
 
 BOOST_AUTO_TEST_CASE(swap) {
@@ -623,6 +1897,11 @@ BOOST_AUTO_TEST_CASE(all_of) {
 	BOOST_CHECK_EQUAL(vta::all_of(&is_true)(true), true);
 	BOOST_CHECK_EQUAL(vta::all_of(&is_true)(false), false);
 	BOOST_CHECK_EQUAL(vta::all_of(&is_true)(true, false), false);
+
+	// Stops at the first argument that fails
+	int calls = 0;
+	BOOST_CHECK_EQUAL(vta::all_of(count_calls{&calls})(true, true, false, true), false);
+	BOOST_CHECK_EQUAL(calls, 3);
 }
 
 BOOST_AUTO_TEST_CASE(any_of) {
@@ -631,6 +1910,10 @@ BOOST_AUTO_TEST_CASE(any_of) {
 	BOOST_CHECK_EQUAL(vta::any_of(is_positive_int{})(0u, 2), true);
 	BOOST_CHECK_EQUAL(vta::any_of(is_positive_int{})(-2), false);
 	BOOST_CHECK_EQUAL(vta::any_of(is_positive_int{})(), false);
+
+	int calls = 0;
+	BOOST_CHECK_EQUAL(vta::any_of(count_calls{&calls})(false, true, false, true), true);
+	BOOST_CHECK_EQUAL(calls, 2);
 }
 
 BOOST_AUTO_TEST_CASE(none_of) {
@@ -639,6 +1922,10 @@ BOOST_AUTO_TEST_CASE(none_of) {
 	BOOST_CHECK_EQUAL(vta::none_of(is_positive_int{})(0u, 2), false);
 	BOOST_CHECK_EQUAL(vta::none_of(is_positive_int{})(-2), true);
 	BOOST_CHECK_EQUAL(vta::none_of(is_positive_int{})(), true);
+
+	int calls = 0;
+	BOOST_CHECK_EQUAL(vta::none_of(count_calls{&calls})(false, true, false), false);
+	BOOST_CHECK_EQUAL(calls, 2);
 }
 
 BOOST_AUTO_TEST_CASE(macro) {
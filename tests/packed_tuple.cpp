@@ -0,0 +1,152 @@
+#include "vta/packed_tuple.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <any>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// The size of Ts... laid out with no padding between them, rounded up to the strictest alignment
+template <typename... Ts>
+constexpr std::size_t unpadded_size() {
+	std::size_t const sizes[] = {sizeof(Ts)..., 0};
+	std::size_t const alignments[] = {alignof(Ts)..., 1};
+	std::size_t size = 0;
+	std::size_t alignment = 1;
+	for(std::size_t i = 0; i < sizeof...(Ts); ++i) {
+		size += sizes[i];
+		alignment = alignments[i] > alignment ? alignments[i] : alignment;
+	}
+	return (size + alignment - 1) / alignment * alignment;
+}
+
+// Whether packed_tuple<Ts...> is no larger than Ts... with no padding between them
+template <typename... Ts>
+constexpr bool is_packed() {
+	return sizeof(vta::packed_tuple<Ts...>) == unpadded_size<Ts...>();
+}
+
+// Can be constructed from anything, as std::any can
+struct from_anything {
+	bool copied = false;
+
+	from_anything() = default;
+
+	from_anything(from_anything const&)
+	: copied(true) {
+	}
+
+	template <typename T>
+	from_anything(T&&) {
+	}
+};
+
+struct collect_strings {
+	std::vector<std::string>* strings;
+
+	template <typename... Args>
+	void operator()(Args const&... args) const {
+		int const expand[] = {0, (strings->push_back(std::to_string(args)), 0)...};
+		static_cast<void>(expand);
+	}
+};
+
+}
+
+BOOST_AUTO_TEST_SUITE(packed_tuple)
+
+BOOST_AUTO_TEST_CASE(size) {
+	typedef std::tuple<char, double, short, std::int64_t> padded;
+	typedef vta::packed_tuple<char, double, short, std::int64_t> packed;
+	static_assert(sizeof(packed) == 24, "");
+	static_assert(sizeof(packed) < sizeof(padded), "");
+	static_assert(packed::size == 4, "");
+
+	static_assert(is_packed<char, double, short, std::int64_t>(), "");
+	static_assert(is_packed<bool, int, char, double, bool, float, short>(), "");
+	static_assert(is_packed<char, std::int64_t, char, std::int64_t, char, std::int64_t>(), "");
+	static_assert(is_packed<std::int64_t, int, short, char>(), "");
+	static_assert(is_packed<char>(), "");
+	static_assert(sizeof(vta::packed_tuple<char, std::int64_t, char, std::int64_t, char, std::int64_t>)
+	              < sizeof(std::tuple<char, std::int64_t, char, std::int64_t, char, std::int64_t>), "");
+}
+
+BOOST_AUTO_TEST_CASE(get) {
+	vta::packed_tuple<char, double, short, std::int64_t> t{'a', 1.5, 3, 4};
+	static_assert(std::is_same<decltype(vta::get<0>(t)), char&>::value, "");
+	static_assert(std::is_same<decltype(vta::get<1>(t)), double&>::value, "");
+	static_assert(std::is_same<decltype(vta::get<2>(std::move(t))), short&&>::value, "");
+	BOOST_CHECK_EQUAL(vta::get<0>(t), 'a');
+	BOOST_CHECK_EQUAL(vta::get<1>(t), 1.5);
+	BOOST_CHECK_EQUAL(vta::get<2>(t), 3);
+	BOOST_CHECK_EQUAL(vta::get<3>(t), 4);
+
+	vta::get<2>(t) = 30;
+	auto const copy = t;
+	BOOST_CHECK_EQUAL(vta::get<2>(copy), 30);
+	BOOST_CHECK_EQUAL(vta::get<3>(copy), 4);
+
+	// The doubles are laid out before the char, but are still reached by their declared positions
+	BOOST_CHECK(static_cast<void const*>(&vta::get<1>(t)) < static_cast<void const*>(&vta::get<0>(t)));
+
+	constexpr vta::packed_tuple<char, double, int> constant{'b', 2.5, 7};
+	static_assert(vta::get<0>(constant) == 'b', "");
+	static_assert(vta::get<1>(constant) == 2.5, "");
+	static_assert(vta::get<2>(constant) == 7, "");
+}
+
+BOOST_AUTO_TEST_CASE(construction) {
+	vta::packed_tuple<int, double, char> zeros;
+	BOOST_CHECK_EQUAL(vta::get<0>(zeros), 0);
+	BOOST_CHECK_EQUAL(vta::get<1>(zeros), 0.0);
+	BOOST_CHECK_EQUAL(vta::get<2>(zeros), '\0');
+
+	// Elements are converted from their arguments as std::tuple does
+	vta::packed_tuple<std::int64_t, std::string> converted{1, "one"};
+	BOOST_CHECK_EQUAL(vta::get<0>(converted), 1);
+	BOOST_CHECK_EQUAL(vta::get<1>(converted), "one");
+
+	vta::packed_tuple<char, std::unique_ptr<int>> owner{'c', std::make_unique<int>(5)};
+	auto const moved = std::move(owner);
+	BOOST_CHECK_EQUAL(*vta::get<1>(moved), 5);
+	BOOST_CHECK(vta::get<1>(owner) == nullptr);
+
+	// A non-const packed_tuple is copied, rather than taken as the argument for its only element
+	vta::packed_tuple<from_anything> anything;
+	vta::packed_tuple<from_anything> const copy = anything;
+	BOOST_CHECK(vta::get<0>(copy).copied);
+
+#if defined(__cpp_lib_any)
+	vta::packed_tuple<std::any> any{5};
+	vta::packed_tuple<std::any> const any_copy = any;
+	BOOST_CHECK_EQUAL(std::any_cast<int>(vta::get<0>(any_copy)), 5);
+#endif
+}
+
+BOOST_AUTO_TEST_CASE(tuple_like) {
+	typedef vta::packed_tuple<char, double, short> packed;
+	static_assert(std::tuple_size<packed>::value == 3, "");
+	static_assert(std::is_same<std::tuple_element<1, packed>::type, double>::value, "");
+
+	// The elements are passed in declaration order
+	std::vector<std::string> strings;
+	vta::apply_after<vta::id>(collect_strings{&strings}, packed{'a', 2.0, 3});
+	BOOST_CHECK((strings == std::vector<std::string>{std::to_string('a'), std::to_string(2.0), "3"}));
+
+#if defined(__cpp_structured_bindings)
+	auto [c, d, s] = packed{'b', 4.0, 5};
+	BOOST_CHECK_EQUAL(c, 'b');
+	BOOST_CHECK_EQUAL(d, 4.0);
+	BOOST_CHECK_EQUAL(s, 5);
+#endif
+}
+
+BOOST_AUTO_TEST_SUITE_END()
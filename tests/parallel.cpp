@@ -0,0 +1,156 @@
+#include "vta/parallel.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct record_thread {
+	template <typename T>
+	void operator()(T& slot) const {
+		slot.second = std::this_thread::get_id();
+		slot.first = true;
+	}
+};
+
+struct length {
+	template <typename T>
+	void operator()(std::pair<T, std::size_t>& slot) const {
+		slot.second = slot.first.size();
+	}
+};
+
+// Runs every task immediately on the calling thread and counts them
+struct inline_executor {
+	template <typename Task>
+	void execute(Task&& task) {
+		++executed;
+		task();
+	}
+
+	int executed = 0;
+};
+
+struct throwing_executor {
+	template <typename Task>
+	void execute(Task&&) {
+		throw std::runtime_error{"queue is full"};
+	}
+};
+
+struct throw_if_negative {
+	void operator()(int i) const {
+		if(i < 0) {
+			throw std::invalid_argument{std::to_string(i)};
+		}
+	}
+};
+
+struct take_ownership {
+	void operator()(std::unique_ptr<int> p) const {
+		*p += 1;
+	}
+};
+
+}
+
+BOOST_AUTO_TEST_SUITE(parallel)
+
+BOOST_AUTO_TEST_CASE(thread_pool) {
+	std::atomic<int> count{0};
+	{
+		vta::thread_pool pool{3};
+		BOOST_CHECK_EQUAL(pool.size(), 3u);
+		for(int i = 0; i < 100; ++i) {
+			pool.execute([&count] { ++count; });
+		}
+	}
+	BOOST_CHECK_EQUAL(count.load(), 100);
+}
+
+BOOST_AUTO_TEST_CASE(par_map) {
+	vta::thread_pool pool{2};
+
+	std::pair<std::string, std::size_t> a{"one", 0};
+	std::pair<std::vector<int>, std::size_t> b{{1, 2, 3, 4}, 0};
+	std::pair<std::string, std::size_t> c{"", 42};
+	vta::par_map(length{}, pool)(a, b, c);
+	BOOST_CHECK_EQUAL(a.second, 3u);
+	BOOST_CHECK_EQUAL(b.second, 4u);
+	BOOST_CHECK_EQUAL(c.second, 0u);
+
+	using slot = std::pair<bool, std::thread::id>;
+	std::vector<slot> slots(4);
+	vta::par_map(record_thread{})(slots[0], slots[1], slots[2], slots[3]);
+	for(auto const& s : slots) {
+		BOOST_CHECK(s.first);
+	}
+	BOOST_CHECK(slots[0].second == std::this_thread::get_id());
+
+	vta::par_map(length{}, pool)();
+}
+
+BOOST_AUTO_TEST_CASE(par_map_executor) {
+	inline_executor executor;
+	std::string a = "a";
+	std::string b = "bb";
+	std::string c = "ccc";
+	std::pair<std::string&, std::size_t> slots[] = {{a, 0}, {b, 0}, {c, 0}};
+	vta::par_map(length{}, executor)(slots[0], slots[1], slots[2]);
+	BOOST_CHECK_EQUAL(slots[0].second, 1u);
+	BOOST_CHECK_EQUAL(slots[1].second, 2u);
+	BOOST_CHECK_EQUAL(slots[2].second, 3u);
+
+	// The first argument is always handled by the calling thread
+	BOOST_CHECK_EQUAL(executor.executed, 2);
+
+	// Tasks that the executor rejects are run on the calling thread
+	throwing_executor rejecting;
+	std::pair<std::string, std::size_t> d{"dddd", 0};
+	std::pair<std::string, std::size_t> e{"eeeee", 0};
+	vta::par_map(length{}, rejecting)(d, e);
+	BOOST_CHECK_EQUAL(d.second, 4u);
+	BOOST_CHECK_EQUAL(e.second, 5u);
+}
+
+BOOST_AUTO_TEST_CASE(par_map_exceptions) {
+	vta::thread_pool pool{2};
+	BOOST_CHECK_THROW(vta::par_map(throw_if_negative{}, pool)(1, -2, 3), std::invalid_argument);
+	BOOST_CHECK_NO_THROW(vta::par_map(throw_if_negative{}, pool)(1, 2, 3));
+
+	// The exception of the earliest argument is the one rethrown
+	try {
+		vta::par_map(throw_if_negative{}, pool)(1, -2, -3, 4);
+		BOOST_ERROR("no exception was thrown");
+	} catch(std::invalid_argument const& e) {
+		BOOST_CHECK_EQUAL(e.what(), std::string{"-2"});
+	}
+}
+
+BOOST_AUTO_TEST_CASE(par_map_forwarding) {
+	vta::thread_pool pool{2};
+	std::unique_ptr<int> a{new int{1}};
+	std::unique_ptr<int> b{new int{2}};
+	vta::par_map(take_ownership{}, pool)(std::move(a), std::move(b));
+	BOOST_CHECK(!a);
+	BOOST_CHECK(!b);
+}
+
+BOOST_AUTO_TEST_CASE(nested_par_map) {
+	// Every outer task waits for an inner par_map on the same single thread, which only finishes
+	// because waiting threads run queued tasks themselves
+	vta::thread_pool pool{1};
+	std::atomic<int> count{0};
+	auto inner = [&count](int) { ++count; };
+	auto outer = [&pool, &inner](int) { vta::par_map(inner, pool)(1, 2, 3); };
+	vta::par_map(outer, pool)(1, 2, 3, 4);
+	BOOST_CHECK_EQUAL(count.load(), 12);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,197 @@
+#include "vta/reduce.hpp"
+
+#include "test_helpers.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using vta_test::string_concat;
+
+// The values reduced for a pack of size N, chosen so that sums of floating point values are exact
+template <typename T>
+T value(std::size_t i) {
+	return static_cast<T>((i * 37 + 11) % 101);
+}
+
+// Checks that reduce gives the same result as a loop over value<T>(0), ..., value<T>(N)
+template <typename T, typename Function, std::size_t... Is>
+void check_reduce(Function f, std::index_sequence<Is...>) {
+	T expected = value<T>(sizeof...(Is));
+	for(std::size_t i = 0; i < sizeof...(Is); ++i) {
+		expected = f(expected, value<T>(i));
+	}
+	T const actual = vta::reduce(f)(value<T>(sizeof...(Is)), value<T>(Is)...);
+	BOOST_CHECK_EQUAL(actual, expected);
+}
+
+template <typename T, typename Function>
+void check_sizes(Function f) {
+	check_reduce<T>(f, std::make_index_sequence<0>{});
+	check_reduce<T>(f, std::make_index_sequence<6>{});
+	check_reduce<T>(f, std::make_index_sequence<7>{});
+	check_reduce<T>(f, std::make_index_sequence<15>{});
+	check_reduce<T>(f, std::make_index_sequence<16>{});
+	check_reduce<T>(f, std::make_index_sequence<33>{});
+	check_reduce<T>(f, std::make_index_sequence<100>{});
+	check_reduce<T>(f, std::make_index_sequence<200>{});
+}
+
+#if defined(VTA_HAS_REDUCE_KERNELS)
+
+static_assert(vta::detail::has_reduce_kernels, "");
+
+template <std::size_t I, typename T>
+using element = T const&;
+
+template <typename Operation, std::size_t Bytes, typename T, std::size_t... Is>
+T reduce_vectors(std::vector<T> const& values, std::index_sequence<Is...>) {
+	vta::detail::forward_pack<std::index_sequence<Is...>, element<Is, T>...> const pack{values[Is]...};
+	return vta::detail::vector_reduction<Operation, Bytes, T, sizeof...(Is)>::transform(pack);
+}
+
+// Checks the AVX2 kernel even when the tests are not compiled for AVX2
+template <typename Operation, typename T, std::size_t... Is>
+__attribute__((target("avx2"))) T reduce_avx2(std::vector<T> const& values, std::index_sequence<Is...>) {
+	vta::detail::forward_pack<std::index_sequence<Is...>, element<Is, T>...> const pack{values[Is]...};
+	return vta::detail::vector_reduction<Operation, 32, T, sizeof...(Is)>::transform(pack);
+}
+
+#endif
+
+// Checks each kernel against a scalar loop over the first sizeof...(Is) of values
+template <typename Operation, typename T, std::size_t... Is>
+void check_kernels(std::vector<T> const& values, std::index_sequence<Is...> indices) {
+	T expected = values[0];
+	for(std::size_t i = 1; i < sizeof...(Is); ++i) {
+		Operation::apply(expected, values[i]);
+	}
+
+#if defined(VTA_HAS_REDUCE_KERNELS)
+	BOOST_CHECK_EQUAL((vta::detail::reduce_values<Operation, T>(values[Is]...)), expected);
+	BOOST_CHECK_EQUAL((reduce_vectors<Operation, 16>(values, indices)), expected);
+	if(__builtin_cpu_supports("avx2")) {
+		BOOST_CHECK_EQUAL((reduce_avx2<Operation>(values, indices)), expected);
+	}
+#else
+	static_cast<void>(indices);
+#endif
+}
+
+template <typename Operation, typename T>
+void check_kernels(std::vector<T> const& values) {
+	BOOST_REQUIRE_GE(values.size(), 17u);
+	check_kernels<Operation>(values, std::make_index_sequence<1>{});
+	check_kernels<Operation>(values, std::make_index_sequence<2>{});
+	check_kernels<Operation>(values, std::make_index_sequence<3>{});
+	check_kernels<Operation>(values, std::make_index_sequence<5>{});
+	check_kernels<Operation>(values, std::make_index_sequence<8>{});
+	check_kernels<Operation>(values, std::make_index_sequence<15>{});
+	check_kernels<Operation>(values, std::make_index_sequence<16>{});
+	check_kernels<Operation>(values, std::make_index_sequence<17>{});
+	if(values.size() >= 150) {
+		check_kernels<Operation>(values, std::make_index_sequence<33>{});
+		check_kernels<Operation>(values, std::make_index_sequence<100>{});
+		check_kernels<Operation>(values, std::make_index_sequence<150>{});
+	}
+}
+
+template <typename T>
+std::vector<T> values(std::size_t size) {
+	std::vector<T> v;
+	for(std::size_t i = 0; i < size; ++i) {
+		v.push_back(value<T>(i));
+	}
+	return v;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(reduce)
+
+BOOST_AUTO_TEST_CASE(minimum_maximum) {
+	static_assert(vta::minimum{}(3, 2) == 2, "");
+	static_assert(vta::maximum{}(3, 2) == 3, "");
+
+	int a = 1;
+	int b = 1;
+	BOOST_CHECK_EQUAL(&vta::minimum{}(a, b), &a);
+	BOOST_CHECK_EQUAL(&vta::maximum{}(a, b), &a);
+}
+
+BOOST_AUTO_TEST_CASE(vectorizable) {
+	using vta::detail::is_vectorizable;
+	bool const kernels = vta::detail::has_reduce_kernels;
+	static_assert(is_vectorizable<std::plus<>, int, int, int, int, int, int, int, int>::value == kernels, "");
+	static_assert(is_vectorizable<vta::minimum, double, double const&, double&, double, double, double, double, double>::value == kernels, "");
+
+	// Too few arguments
+	static_assert(!is_vectorizable<std::plus<>, int, int, int>::value, "");
+
+	// Mixed types
+	static_assert(!is_vectorizable<std::plus<>, int, int, int, int, int, int, int, long>::value, "");
+
+	// Unknown operations
+	static_assert(!is_vectorizable<std::minus<>, int, int, int, int, int, int, int, int>::value, "");
+
+	// short + short is an int
+	static_assert(!is_vectorizable<std::plus<>, short, short, short, short, short, short, short, short>::value, "");
+	static_assert(is_vectorizable<vta::maximum, short, short, short, short, short, short, short, short>::value == kernels, "");
+}
+
+BOOST_AUTO_TEST_CASE(reduce) {
+	check_sizes<int>(std::plus<>{});
+	check_sizes<int>(vta::minimum{});
+	check_sizes<int>(vta::maximum{});
+	check_sizes<int>(std::bit_xor<>{});
+	check_sizes<unsigned>(std::bit_or<>{});
+	check_sizes<std::uint64_t>(std::bit_and<>{});
+	check_sizes<std::int64_t>(vta::minimum{});
+	check_sizes<std::int64_t>(std::plus<std::int64_t>{});
+	check_sizes<short>(vta::maximum{});
+	check_sizes<unsigned char>(vta::minimum{});
+	check_sizes<float>(std::plus<>{});
+	check_sizes<float>(vta::maximum{});
+	check_sizes<double>(std::plus<>{});
+	check_sizes<double>(vta::minimum{});
+
+	// Everything else falls back to fold_tree
+	BOOST_CHECK_EQUAL(vta::reduce(string_concat{})(1, 'a', "b", 2.5), "1ab2.5");
+	BOOST_CHECK_EQUAL(vta::reduce(std::plus<>{})(1, 2u, 3l, 4.5), 10.5);
+	BOOST_CHECK_EQUAL(vta::reduce(std::minus<>{})(1), 1);
+
+	// The result is a value whether or not the kernels are used
+	int const a = 1;
+	auto const minimum = vta::reduce(vta::minimum{});
+	static_assert(std::is_same<decltype(minimum(a)), int>::value, "");
+	static_assert(std::is_same<decltype(minimum(a, a, a)), int>::value, "");
+	static_assert(std::is_same<decltype(minimum(a, a, a, a, a, a, a, a)), int>::value, "");
+	BOOST_CHECK_EQUAL(minimum(3, 1, 2), 1);
+}
+
+BOOST_AUTO_TEST_CASE(kernels) {
+	check_kernels<vta::detail::simd_plus>(values<int>(150));
+	check_kernels<vta::detail::simd_minimum>(values<unsigned>(150));
+	check_kernels<vta::detail::simd_maximum>(values<std::int64_t>(150));
+	check_kernels<vta::detail::simd_bit_xor>(values<std::uint16_t>(150));
+	check_kernels<vta::detail::simd_bit_or>(values<std::uint8_t>(150));
+	check_kernels<vta::detail::simd_plus>(values<double>(150));
+	check_kernels<vta::detail::simd_minimum>(values<float>(150));
+
+	// Negative values and unsigned wrap around
+	std::vector<int> const negative{5, -3, 7, -10, 2, 0, 8, -1, 4, 6, -7, 3, 9, -2, 1, 11, -4};
+	check_kernels<vta::detail::simd_minimum>(negative);
+	check_kernels<vta::detail::simd_maximum>(negative);
+	std::vector<unsigned> const large{4000000000u, 1u, 3000000000u, 2u, 4000000000u, 7u, 8u, 9u, 10u,
+	                                  3000000000u, 11u, 12u, 2000000000u, 13u, 14u, 4000000000u, 15u};
+	check_kernels<vta::detail::simd_plus>(large);
+	check_kernels<vta::detail::simd_maximum>(large);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
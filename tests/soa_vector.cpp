@@ -0,0 +1,164 @@
+#include "vta/soa_vector.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace {
+
+// Throws from its constructor when constructed from a negative value
+struct throws_if_negative {
+	int value;
+
+	throws_if_negative(int v)
+	: value{v} {
+		if(v < 0) {
+			throw std::invalid_argument("negative");
+		}
+	}
+};
+
+template <typename T>
+bool is_cache_line_aligned(T const* p) {
+	return reinterpret_cast<std::uintptr_t>(p) % 64 == 0;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(soa_vector)
+
+BOOST_AUTO_TEST_CASE(push_back) {
+	vta::soa_vector<int, double, char> v;
+	static_assert(decltype(v)::columns == 3, "");
+	static_assert(std::is_same<decltype(v)::element_t<1>, double>::value, "");
+	BOOST_CHECK(v.empty());
+
+	v.push_back(1, 1.5, 'a');
+	int const i = 2;
+	double const d = 2.5;
+	v.push_back(i, d, 'b');
+	v.emplace_back(3, 3, 99);
+	BOOST_CHECK_EQUAL(v.size(), 3);
+	BOOST_CHECK(!v.empty());
+
+	BOOST_CHECK_EQUAL(v.column<0>()[2], 3);
+	BOOST_CHECK_EQUAL(v.column<1>()[1], 2.5);
+	BOOST_CHECK_EQUAL(v.column<2>()[2], 'c');
+
+	v.pop_back();
+	BOOST_CHECK_EQUAL(v.size(), 2);
+	BOOST_CHECK_EQUAL(v.column<2>().size(), 2);
+
+	v.clear();
+	BOOST_CHECK(v.empty());
+	BOOST_CHECK(v.column<1>().empty());
+}
+
+BOOST_AUTO_TEST_CASE(columns) {
+	vta::soa_vector<char, double, std::int16_t> v;
+	v.reserve(100);
+	for(int i = 0; i < 100; ++i) {
+		v.push_back(static_cast<char>(i), i * 0.5, static_cast<std::int16_t>(i * 2));
+	}
+
+	// Each column is contiguous and starts on a cache line
+	auto const doubles = v.column<1>();
+	BOOST_CHECK_EQUAL(doubles.size(), 100);
+	BOOST_CHECK_EQUAL(doubles.end() - doubles.begin(), 100);
+	BOOST_CHECK_EQUAL(std::accumulate(doubles.begin(), doubles.end(), 0.0), 2475.0);
+	BOOST_CHECK(is_cache_line_aligned(v.column<0>().data()));
+	BOOST_CHECK(is_cache_line_aligned(v.column<1>().data()));
+	BOOST_CHECK(is_cache_line_aligned(v.column<2>().data()));
+
+	for(std::int16_t& x : v.column<2>()) {
+		x = static_cast<std::int16_t>(x + 1);
+	}
+	BOOST_CHECK_EQUAL(v.column<2>()[10], 21);
+
+	// Columns can be named by type when the types are unique
+	static_assert(std::is_same<decltype(v.column<double>()), vta::soa_column<double>>::value, "");
+	BOOST_CHECK_EQUAL(v.column<double>().data(), v.column<1>().data());
+	BOOST_CHECK_EQUAL(v.column<char>()[5], 5);
+
+	auto const& constant = v;
+	static_assert(std::is_same<decltype(constant.column<1>()), vta::soa_column<double const>>::value, "");
+	static_assert(std::is_same<decltype(constant.column<char>()), vta::soa_column<char const>>::value, "");
+	BOOST_CHECK_EQUAL(constant.column<std::int16_t>()[10], 21);
+}
+
+BOOST_AUTO_TEST_CASE(rows) {
+	vta::soa_vector<int, std::string, double> v;
+	v.push_back(1, "one", 1.5);
+	v.push_back(2, "two", 2.5);
+
+	auto row = v[1];
+	static_assert(std::is_same<decltype(vta::get<1>(row)), std::string&>::value, "");
+	BOOST_CHECK_EQUAL(row.index(), 1);
+	BOOST_CHECK_EQUAL(vta::get<0>(row), 2);
+	BOOST_CHECK_EQUAL(vta::get<1>(row), "two");
+
+	// Writing through a row writes to the columns
+	vta::get<2>(v[0]) = 10.0;
+	BOOST_CHECK_EQUAL(v.column<2>()[0], 10.0);
+
+	auto const& constant = v;
+	static_assert(std::is_same<decltype(vta::get<1>(constant[0])), std::string const&>::value, "");
+	BOOST_CHECK_EQUAL(vta::get<1>(constant[0]), "one");
+
+	// Rows are tuple-like, with the elements passed in column order
+	static_assert(std::tuple_size<decltype(row)>::value == 3, "");
+	typedef decltype(v)::const_reference const_row;
+	static_assert(std::is_same<std::tuple_element<0, const_row>::type, int const&>::value, "");
+	vta::soa_vector<int, char> numbers;
+	numbers.push_back(3, 'x');
+	auto const reversed = vta::apply_after<vta::reverse>([](char c, int i) { return std::make_pair(c, i); },
+	                                                     numbers[0]);
+	BOOST_CHECK((reversed == std::make_pair('x', 3)));
+
+#if defined(__cpp_structured_bindings)
+	auto [i, s, d] = v[1];
+	i = 20;
+	BOOST_CHECK_EQUAL(v.column<0>()[1], 20);
+	BOOST_CHECK_EQUAL(s, "two");
+	BOOST_CHECK_EQUAL(d, 2.5);
+#endif
+}
+
+BOOST_AUTO_TEST_CASE(move_only_and_repeated_types) {
+	vta::soa_vector<std::unique_ptr<int>, int, int> v;
+	v.push_back(std::make_unique<int>(1), 2, 3);
+	auto p = std::make_unique<int>(4);
+	v.emplace_back(std::move(p), 5, 6);
+	BOOST_CHECK_EQUAL(*v.column<0>()[1], 4);
+	BOOST_CHECK_EQUAL(v.column<1>()[1], 5);
+	BOOST_CHECK_EQUAL(v.column<2>()[1], 6);
+
+	auto moved = std::move(v);
+	BOOST_CHECK_EQUAL(moved.size(), 2);
+	BOOST_CHECK_EQUAL(*vta::get<0>(moved[0]), 1);
+}
+
+BOOST_AUTO_TEST_CASE(exception_safety) {
+	vta::soa_vector<std::string, throws_if_negative, int> v;
+	v.emplace_back("a", 1, 1);
+	BOOST_CHECK_THROW(v.emplace_back("b", -1, 2), std::invalid_argument);
+
+	// The string that was appended before the throw has been removed again
+	BOOST_CHECK_EQUAL(v.size(), 1);
+	BOOST_CHECK_EQUAL(v.column<0>().size(), 1);
+	BOOST_CHECK_EQUAL(v.column<1>().size(), 1);
+	BOOST_CHECK_EQUAL(v.column<2>().size(), 1);
+
+	v.emplace_back("c", 3, 3);
+	BOOST_CHECK_EQUAL(v.column<0>()[1], "c");
+	BOOST_CHECK_EQUAL(v.column<1>()[1].value, 3);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
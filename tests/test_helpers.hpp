@@ -0,0 +1,23 @@
+// Function objects shared by more than one of the unit test files in this directory.
+
+#ifndef INCLUDE_GUARD_FB9709D5_A38A_436C_81CC_4B4B86735B01
+#define INCLUDE_GUARD_FB9709D5_A38A_436C_81CC_4B4B86735B01
+
+#include <sstream>
+#include <string>
+
+namespace vta_test {
+
+// Streams both arguments into a string, so that the result shows the order they were combined in
+struct string_concat {
+	template <typename LHS, typename RHS>
+	std::string operator()(LHS const& lhs, RHS const& rhs) const {
+		std::stringstream ss;
+		ss << lhs << rhs;
+		return ss.str();
+	}
+};
+
+} // namespace vta_test
+
+#endif
@@ -0,0 +1,140 @@
+#include "vta/type_list.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace {
+
+template <std::size_t I>
+struct tag {};
+
+// Returns a type_list of the exact types of the arguments it is called with
+struct record_types {
+	template <typename... Args>
+	constexpr vta::type_list<Args...> operator()(Args&&...) const noexcept {
+		return {};
+	}
+};
+
+// The types that forward_after<Transformation> forwards for arguments of types Ts..., where an
+// rvalue argument of type T is deduced as T and an lvalue as T&
+template <typename Transformation, typename... Ts>
+using forwarded_types = decltype(vta::forward_after<Transformation>(record_types{})(std::declval<Ts>()...));
+
+// Whether transform_t agrees with forward_after for the types Ts...
+template <typename Transformation, typename... Ts>
+constexpr bool consistent() {
+	return std::is_same<vta::transform_t<vta::type_list<Ts...>, Transformation>,
+	                    forwarded_types<Transformation, Ts...>>::value;
+}
+
+template <std::size_t... Is>
+using tags = vta::type_list<tag<Is>...>;
+
+template <std::size_t... Is>
+vta::type_list<tag<Is>...> tags_of(std::index_sequence<Is...>);
+
+template <std::size_t N, std::size_t... Is>
+vta::type_list<tag<N - 1 - Is>...> reversed_tags(std::index_sequence<Is...>);
+
+template <std::size_t... Is>
+vta::type_list<tag<Is % 7>...> repeating_tags(std::index_sequence<Is...>);
+
+template <typename T>
+struct is_reference_to_int : std::is_same<T, int&> {};
+
+template <typename T>
+struct size_of : std::integral_constant<std::size_t, sizeof(T)> {};
+
+}
+
+BOOST_AUTO_TEST_SUITE(type_list)
+
+BOOST_AUTO_TEST_CASE(size) {
+	static_assert(vta::type_list<>::size == 0, "");
+	static_assert(vta::type_list<int, int, char>::size == 3, "");
+
+	// The list used by the predicates is the same type
+	static_assert(std::is_same<vta::type_list<int, char>, vta::detail::type_list<int, char>>::value, "");
+	static_assert(std::is_same<vta::reverse_t<vta::detail::type_list<int, char>>, vta::type_list<char, int>>::value,
+	  "");
+}
+
+BOOST_AUTO_TEST_CASE(reverse) {
+	static_assert(std::is_same<vta::reverse_t<vta::type_list<>>, vta::type_list<>>::value, "");
+	static_assert(std::is_same<vta::reverse_t<vta::type_list<int, char&, void>>,
+	                           vta::type_list<void, char&, int>>::value, "");
+
+	typedef std::make_index_sequence<300> sequence;
+	static_assert(std::is_same<vta::reverse_t<decltype(tags_of(sequence{}))>,
+	                           decltype(reversed_tags<300>(sequence{}))>::value, "");
+}
+
+BOOST_AUTO_TEST_CASE(filter) {
+	typedef vta::type_list<int, double, int&, char, int const&, int&> list;
+	static_assert(std::is_same<vta::filter_t<list, std::is_integral>, vta::type_list<int, char>>::value, "");
+	static_assert(std::is_same<vta::filter_t<list, is_reference_to_int>, vta::type_list<int&, int&>>::value, "");
+	static_assert(std::is_same<vta::filter_t<list, std::is_void>, vta::type_list<>>::value, "");
+}
+
+BOOST_AUTO_TEST_CASE(permute_slice) {
+	typedef vta::type_list<tag<0>, tag<1>, tag<2>, tag<3>> list;
+	static_assert(std::is_same<vta::permute_t<list, 3, 0, -2>, vta::type_list<tag<3>, tag<0>, tag<2>>>::value, "");
+	static_assert(std::is_same<vta::slice_t<list, 1, 2>, vta::type_list<tag<1>, tag<2>>>::value, "");
+	static_assert(std::is_same<vta::slice_t<list, 0, -1>, list>::value, "");
+	static_assert(std::is_same<vta::transform_t<list, vta::swap<0, -1>>,
+	                           vta::type_list<tag<3>, tag<1>, tag<2>, tag<0>>>::value, "");
+}
+
+BOOST_AUTO_TEST_CASE(at_index_of) {
+	typedef vta::type_list<int, char&, void, char&> list;
+	static_assert(std::is_same<vta::list_at_t<list, 0>, int>::value, "");
+	static_assert(std::is_same<vta::list_at_t<list, 2>, void>::value, "");
+	static_assert(std::is_same<vta::list_at_t<list, -1>, char&>::value, "");
+	static_assert(vta::index_of<list, int>::value == 0, "");
+	static_assert(vta::index_of<list, char&>::value == 1, "");
+	static_assert(vta::index_of<list, void>::value == 2, "");
+
+	typedef std::make_index_sequence<300> sequence;
+	static_assert(std::is_same<vta::list_at_t<decltype(tags_of(sequence{})), 250>, tag<250>>::value, "");
+	static_assert(vta::index_of<decltype(tags_of(sequence{})), tag<299>>::value == 299, "");
+}
+
+BOOST_AUTO_TEST_CASE(unique) {
+	static_assert(std::is_same<vta::unique_t<vta::type_list<>>, vta::type_list<>>::value, "");
+	static_assert(std::is_same<vta::unique_t<vta::type_list<int, char, int, int&, char>>,
+	                           vta::type_list<int, char, int&>>::value, "");
+
+	typedef decltype(repeating_tags(std::make_index_sequence<300>{})) repeating;
+	static_assert(std::is_same<vta::unique_t<repeating>, tags<0, 1, 2, 3, 4, 5, 6>>::value, "");
+}
+
+BOOST_AUTO_TEST_CASE(apply) {
+	static_assert(std::is_same<vta::apply_t<vta::type_list<int, char&>, std::tuple>, std::tuple<int, char&>>::value, "");
+	static_assert(std::is_same<vta::apply_t<vta::reverse_t<vta::type_list<int, char&>>, std::tuple>,
+	                           std::tuple<char&, int>>::value, "");
+}
+
+// The type level transformations select the same types as the value level ones forward
+BOOST_AUTO_TEST_CASE(consistent_with_transformations) {
+	static_assert(consistent<vta::id, int, char&, double, char const&>(), "");
+	static_assert(consistent<vta::flip, int, char&, double, char const&>(), "");
+	static_assert(consistent<vta::reverse, int, char&, double, char const&>(), "");
+	static_assert(consistent<vta::filter<std::is_integral>, int, char&, double, char, long>(), "");
+	static_assert(consistent<vta::filter<is_reference_to_int>, int, int&, double, int&>(), "");
+	static_assert(consistent<vta::permute<2, 0, -1>, int, char&, double, char const&>(), "");
+	static_assert(consistent<vta::slice<1, -2>, int, char&, double, char const&>(), "");
+	static_assert(consistent<vta::swap<1, -1>, int, char&, double, char const&>(), "");
+	static_assert(consistent<vta::cycle<0, 2, 3>, int, char&, double, char const&>(), "");
+	static_assert(consistent<vta::shift<2>, int, char&, double, char const&>(), "");
+	static_assert(consistent<vta::shift_tail<-1>, int, char&, double, char const&>(), "");
+	static_assert(consistent<vta::take<2>, int, char&, double, char const&>(), "");
+	static_assert(consistent<vta::drop<3>, int, char&, double, char const&>(), "");
+	static_assert(consistent<vta::sort_by<size_of>, double, char&, int, char const&, short>(), "");
+}
+
+BOOST_AUTO_TEST_SUITE_END()